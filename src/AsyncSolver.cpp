@@ -0,0 +1,118 @@
+#include "AsyncSolver.hpp"
+
+#include <utility>
+
+namespace Cluedo {
+
+AsyncSolver::AsyncSolver(std::function<void()> on_result_ready)
+  : m_on_result_ready(std::move(on_result_ready))
+  , m_worker([this](std::stop_token stop_token) { run(stop_token); }) {
+}
+
+std::size_t AsyncSolver::request(Solver&& solver) {
+	std::size_t version;
+	{
+		std::lock_guard lock(m_mutex);
+		version = m_next_version++;
+		m_request.emplace(version, std::move(solver));
+		m_solve_stop_source.request_stop();
+	}
+
+	m_request_condition.notify_one();
+	return version;
+}
+
+void AsyncSolver::cancel() {
+	std::lock_guard lock(m_mutex);
+	m_request.reset();
+	m_solve_stop_source.request_stop();
+}
+
+std::optional<SolveResult> AsyncSolver::take_result() {
+	std::lock_guard lock(m_mutex);
+	return std::exchange(m_result, std::nullopt);
+}
+
+std::optional<SolveResult> AsyncSolver::partial_result() const {
+	auto version = m_progress_version.load(std::memory_order_acquire);
+	if (version == 0)
+		return std::nullopt;
+
+	auto sample_count = m_progress.sample_count();
+	auto solutions = m_progress.solutions();
+	auto card_ownership = m_progress.card_ownership_probabilities();
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (m_progress_version.load(std::memory_order_relaxed) != version)
+		return std::nullopt;
+
+	return SolveResult { version, std::move(solutions), sample_count, std::move(card_ownership) };
+}
+
+std::optional<std::size_t> AsyncSolver::partial_sample_count(std::size_t version) const {
+	if (m_progress_version.load(std::memory_order_acquire) != version)
+		return std::nullopt;
+
+	auto sample_count = m_progress.sample_count();
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (m_progress_version.load(std::memory_order_relaxed) != version)
+		return std::nullopt;
+
+	return sample_count;
+}
+
+SolveStatistics AsyncSolver::statistics() {
+	std::lock_guard lock(m_mutex);
+	auto statistics = m_statistics;
+	if (m_solve_start)
+		statistics.busy_duration += std::chrono::steady_clock::now() - *m_solve_start;
+
+	return statistics;
+}
+
+void AsyncSolver::run(std::stop_token stop_token) {
+	while (true) {
+		std::optional<Request> request;
+		std::stop_source solve_stop_source;
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_request_condition.wait(lock, stop_token, [this] { return m_request.has_value(); }))
+				return;
+
+			request = std::exchange(m_request, std::nullopt);
+			m_solve_stop_source = solve_stop_source;
+			m_solve_start = std::chrono::steady_clock::now();
+		}
+
+		// The solve also has to stop when the thread itself is asked to stop.
+		std::stop_callback stop_solve_callback(stop_token, [solve_stop_source]() mutable { solve_stop_source.request_stop(); });
+
+		m_progress_version.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_progress.reset(request->solver.player_count());
+		m_progress_version.store(request->version, std::memory_order_release);
+
+		auto solutions = request->solver.find_most_likely_solutions(&m_progress, solve_stop_source.get_token());
+
+		{
+			std::lock_guard lock(m_mutex);
+			auto solve_duration = std::chrono::steady_clock::now() - *std::exchange(m_solve_start, std::nullopt);
+			m_statistics.busy_duration += solve_duration;
+
+			// A stopped solve was replaced by a newer request or cancelled, so its result is outdated.
+			if (solve_stop_source.stop_requested())
+				continue;
+
+			m_statistics.last_solve_duration = solve_duration;
+			m_statistics.last_sample_count = m_progress.sample_count();
+			m_statistics.last_valid_sample_count = m_progress.valid_sample_count();
+			m_result = SolveResult { request->version, std::move(solutions), m_statistics.last_sample_count, m_progress.card_ownership_probabilities() };
+		}
+
+		if (m_on_result_ready)
+			m_on_result_ready();
+	}
+}
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "SolveProgress.hpp"
+#include "Solver.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+/// \file AsyncSolver.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::AsyncSolver class.
+
+namespace Cluedo {
+
+/// \brief The solutions found for a request made to an \ref Cluedo::AsyncSolver.
+struct SolveResult {
+	std::size_t version;                                    ///< The version of the request the solutions were found for.
+	std::vector<Solver::SolutionProbabilityPair> solutions; ///< The solutions ordered by their probability.
+	std::size_t sample_count;                               ///< The number of samples the probabilities are based on.
+	Solver::CardOwnershipProbabilities card_ownership;      ///< The probabilities of each player holding each card.
+};
+
+/// \brief The statistics of the work done by an \ref Cluedo::AsyncSolver.
+struct SolveStatistics {
+	std::chrono::nanoseconds last_solve_duration; ///< How long the last completed solve took.
+	std::size_t last_sample_count;                ///< The number of samples taken by the last completed solve.
+	std::size_t last_valid_sample_count;          ///< The number of valid samples taken by the last completed solve.
+	std::chrono::nanoseconds busy_duration;       ///< The total time spent solving, including the solve in progress.
+};
+
+/// \brief A solver that finds the most likely solutions on a background thread.
+///
+/// Every request gets a version number, which increases with every request,
+/// and the results are returned along with the version of the request they
+/// were found for. This way the caller can tell if a result is still relevant
+/// or if it belongs to a state of the game that was replaced in the meantime.
+///
+/// Only the newest request is ever solved: a new request replaces the one
+/// waiting to be solved, if any, and stops the one being solved, whose result
+/// is never returned. This way no time is spent on states of the game that
+/// were already replaced.
+///
+/// While a request is being solved, the estimates found so far can be read
+/// with \ref partial_result.
+class AsyncSolver {
+public:
+	/// Constructs the solver and starts its background thread.
+	///
+	/// \param on_result_ready The function to be called from the background
+	/// thread when a new result is ready to be taken.
+	explicit AsyncSolver(std::function<void()> on_result_ready = {});
+
+	AsyncSolver(AsyncSolver const&) = delete;
+	AsyncSolver& operator=(AsyncSolver const&) = delete;
+
+	/// Requests the most likely solutions of a game.
+	///
+	/// \param solver The solver of the game to find the solutions of.
+	///
+	/// \return The version of the request.
+	std::size_t request(Solver&& solver);
+
+	/// Drops the request waiting to be solved and stops the one being solved, if any.
+	void cancel();
+
+	/// Takes the last result found, if any.
+	/// \note Each result can only be taken once.
+	///
+	/// \return The last result found or `std::nullopt` if there isn't a new one.
+	std::optional<SolveResult> take_result();
+
+	/// Returns the estimate of the solutions of the last request that started being solved.
+	/// \note This method never waits for the background thread.
+	///
+	/// \return The estimate of the solutions or `std::nullopt` if no request started being solved.
+	std::optional<SolveResult> partial_result() const;
+
+	/// Returns the number of samples taken so far for a request, without copying its estimate.
+	/// This way the caller can tell if the estimate changed before reading it with \ref partial_result.
+	/// \note This method never waits for the background thread.
+	///
+	/// \param version The version of the request.
+	///
+	/// \return The number of samples or `std::nullopt` if the request isn't the last one that started being solved.
+	std::optional<std::size_t> partial_sample_count(std::size_t version) const;
+
+	/// Returns the statistics of the work done so far.
+	///
+	/// \return The statistics of the work done so far.
+	SolveStatistics statistics();
+
+private:
+	void run(std::stop_token stop_token);
+
+	struct Request {
+		std::size_t version;
+		Solver solver;
+	};
+
+	std::function<void()> m_on_result_ready;
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_request_condition;
+	std::optional<Request> m_request;
+	std::stop_source m_solve_stop_source;
+	std::optional<SolveResult> m_result;
+	std::size_t m_next_version { 1 };
+
+	SolveStatistics m_statistics {};
+	std::optional<std::chrono::steady_clock::time_point> m_solve_start;
+
+	// The version is zero while the progress is being reset, so that readers
+	// can tell if the progress they read belongs to a single request.
+	SolveProgress m_progress;
+	std::atomic<std::size_t> m_progress_version { 0 };
+
+	// The thread is the last member so that it is stopped and joined before the others are destroyed.
+	std::jthread m_worker;
+};
+
+}
@@ -1,21 +1,26 @@
 #include "Card.hpp"
 
+#include <algorithm>
 #include <cassert>
 
-#include "LanguageStrings.hpp"
-
 namespace Cluedo {
 
-std::string_view format_as(CardCategory category) {
-	using namespace std::literals;
+using namespace std::literals;
 
+static constexpr std::array card_names {
+#define _ENUMERATE_CARD(x) #x##sv,
+	_ENUMERATE_CARDS
+#undef _ENUMERATE_CARD
+};
+
+std::string_view format_as(CardCategory category) {
 	switch (category) {
 	case CardCategory::Suspect:
-		return Cluedo::LanguageStrings::the().get_string("CardCategory.Suspect"sv);
+		return "Suspect"sv;
 	case CardCategory::Weapon:
-		return Cluedo::LanguageStrings::the().get_string("CardCategory.Weapon"sv);
+		return "Weapon"sv;
 	case CardCategory::Room:
-		return Cluedo::LanguageStrings::the().get_string("CardCategory.Room"sv);
+		return "Room"sv;
 	default:
 		assert(false);
 		return ""sv;
@@ -23,18 +28,16 @@ std::string_view format_as(CardCategory category) {
 }
 
 std::string_view format_as(Card card) {
-	using namespace std::literals;
+	assert(card < Card::_Count);
+	return card_names[static_cast<std::size_t>(card)];
+}
 
-	switch (card) {
-#define _ENUMERATE_CARD(x) \
-	case Card::x:            \
-		return Cluedo::LanguageStrings::the().get_string("Card." #x##sv);
-		_ENUMERATE_CARDS
-#undef _ENUMERATE_CARD
-	default:
-		assert(false);
-		return ""sv;
-	}
+std::optional<Card> CardUtils::card_from_name(std::string_view name) {
+	auto it = std::find(card_names.begin(), card_names.end(), name);
+	if (it == card_names.end())
+		return std::nullopt;
+
+	return static_cast<Card>(it - card_names.begin());
 }
 
 };
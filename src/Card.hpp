@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <string_view>
 
 /// \file Card.hpp
@@ -20,6 +21,8 @@ enum class CardCategory : std::uint8_t {
 /// \note This function is meant to be used by the
 /// <a href="https://github.com/fmtlib/fmt">{fmt}</a> library to format the
 /// card categories correctly.
+/// \note The string is the name of the enum value, which doesn't depend on
+/// the language, use \ref LS to get the translated one.
 std::string_view format_as(CardCategory);
 
 /// \def _ENUMERATE_SUSPECTS
@@ -74,6 +77,8 @@ enum class Card : std::uint8_t {
 /// \note This function is meant to be used by the
 /// <a href="https://github.com/fmtlib/fmt">{fmt}</a> library to format the
 /// cards correctly.
+/// \note The string is the name of the enum value, which doesn't depend on
+/// the language, use \ref LS to get the translated one.
 std::string_view format_as(Card);
 
 /// \brief A series of utilities for the cards.
@@ -98,6 +103,13 @@ struct CardUtils {
 		return CardCategory::Room;
 	}
 
+	/// Returns the card with the given name.
+	///
+	/// \param name The name of the card, as formatted by \ref format_as(Card).
+	///
+	/// \return The card with the given name or `std::nullopt` if there isn't one.
+	static std::optional<Card> card_from_name(std::string_view name);
+
 	/// An iterator for cards.
 	struct CardIterator {
 		std::uint8_t index; ///< The index of the card.
@@ -94,6 +94,17 @@ public:
 	constexpr CardSet(std::bitset<CardUtils::CARD_COUNT> set)
 	  : m_set(set), m_size(set.count()) {}
 
+	/// Constructs a set from a bit mask.
+	///
+	/// \param mask The mask, where the bit `i` is set if the card with index `i` is in the set.
+	///
+	/// \return The set.
+	static constexpr CardSet from_mask(std::uint32_t mask) { return std::bitset<CardUtils::CARD_COUNT>(mask); }
+	/// Returns the set as a bit mask.
+	///
+	/// \return The mask, where the bit `i` is set if the card with index `i` is in the set.
+	constexpr std::uint32_t mask() const { return static_cast<std::uint32_t>(m_set.to_ulong()); }
+
 	/// Returns the number of cards in the set.
 	///
 	/// \return The number of cards in the set.
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// \file DeductionRule.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::DeductionRule enum.
+
+namespace Cluedo {
+
+/// \enum DeductionRule
+/// \brief The rules with which the solver infers new information.
+enum class DeductionRule : std::uint8_t {
+	OwnedCard,           ///< A card held by a player isn't held by anyone else.
+	LastPossibleOwner,   ///< A card that all the players but one haven't got is held by that one.
+	SolutionCategory,    ///< The only card of a category that may not be held by a player is in the solution.
+	SharedPossibilities, ///< If as many players as cards each have one of the same cards, nobody else has any of them.
+	SinglePossibility,   ///< A player that has one of some cards, all of which but one they haven't got, has that one.
+	FullHand,            ///< A player whose cards are all known hasn't got any other card.
+	_Count,
+};
+
+/// \typedef DeductionCounts
+/// \brief The number of facts inferred by each \ref DeductionRule, indexed by the rule.
+using DeductionCounts = std::array<std::size_t, static_cast<std::size_t>(DeductionRule::_Count)>;
+
+}
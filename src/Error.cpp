@@ -1,24 +1,21 @@
 #include "Error.hpp"
 
+#include <array>
 #include <cassert>
 
-#include "LanguageStrings.hpp"
-
 namespace Cluedo {
 
 std::string_view format_as(Error error) {
 	using namespace std::literals;
 
-	switch (error) {
-#define _ENUMERATE_ERROR(x) \
-	case Error::x:            \
-		return Cluedo::LanguageStrings::the().get_string("Error." #x##sv);
+	static constexpr std::array error_names {
+#define _ENUMERATE_ERROR(x) #x##sv,
 		_ENUMERATE_ERRORS
 #undef _ENUMERATE_ERROR
-	}
+	};
 
-	assert(false);
-	return ""sv;
+	assert(static_cast<std::size_t>(error) < error_names.size());
+	return error_names[static_cast<std::size_t>(error)];
 }
 
 }
@@ -12,7 +12,18 @@ namespace Cluedo {
 #define _ENUMERATE_ERRORS                  \
 	_ENUMERATE_ERROR(InvalidNumberOfPlayers) \
 	_ENUMERATE_ERROR(InvalidNumberOfCards)   \
-	_ENUMERATE_ERROR(InvalidInformation)
+	_ENUMERATE_ERROR(InvalidInformation)     \
+	_ENUMERATE_ERROR(InvalidGameRecord)      \
+	_ENUMERATE_ERROR(InvalidRequest)         \
+	_ENUMERATE_ERROR(NoGameInProgress)       \
+	_ENUMERATE_ERROR(MemoryLimitExceeded)    \
+	_ENUMERATE_ERROR(TooManyPendingSolves)   \
+	_ENUMERATE_ERROR(SolveCancelled)         \
+	_ENUMERATE_ERROR(TooManySessions)        \
+	_ENUMERATE_ERROR(InvalidSolverState)     \
+	_ENUMERATE_ERROR(InvalidGameCorpus)      \
+	_ENUMERATE_ERROR(CouldNotOpenFile)       \
+	_ENUMERATE_ERROR(CouldNotWriteFile)
 
 /// \enum Error
 /// The list of errors that can occur in the application.
@@ -26,6 +37,8 @@ enum class Error {
 /// \note This function is meant to be used by the
 /// <a href="https://github.com/fmtlib/fmt">{fmt}</a> library to format the
 /// errors correctly.
+/// \note The string is the name of the enum value, which doesn't depend on
+/// the language, use \ref LS to get the translated one.
 std::string_view format_as(Error error);
 
 }
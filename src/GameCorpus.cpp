@@ -0,0 +1,104 @@
+#include "GameCorpus.hpp"
+
+#include "utils/BinaryStream.hpp"
+
+#include <limits>
+
+using namespace std::literals;
+
+namespace Cluedo {
+
+static constexpr auto MAGIC = "CLGC"sv;
+
+static std::string header(std::uint64_t record_count, std::uint64_t index_offset) {
+	std::string data;
+	BinaryWriter writer(data);
+	writer.write_bytes(MAGIC);
+	writer.write(GameCorpus::VERSION);
+	writer.write_bytes("\0\0\0"sv);
+	writer.write(record_count);
+	writer.write(index_offset);
+	return data;
+}
+
+Result<GameCorpus, Error> GameCorpus::open(std::string const& path) {
+	auto file = MappedFile::open(path);
+	if (!file)
+		return Error::CouldNotOpenFile;
+
+	auto data = file->data();
+	if (!data.starts_with(MAGIC))
+		return Error::InvalidGameCorpus;
+
+	BinaryReader reader(data.substr(MAGIC.size()));
+	auto version = reader.read<std::uint8_t>();
+	reader.read_bytes(3);
+	auto record_count = reader.read<std::uint64_t>();
+	auto index_offset = reader.read<std::uint64_t>();
+	if (version != VERSION || !record_count || !index_offset)
+		return Error::InvalidGameCorpus;
+
+	// The index must be right at the end of the file.
+	if (*index_offset < HEADER_SIZE || *index_offset > data.size() || (data.size() - *index_offset) / INDEX_ENTRY_SIZE != *record_count || (data.size() - *index_offset) % INDEX_ENTRY_SIZE != 0)
+		return Error::InvalidGameCorpus;
+
+	GameCorpus corpus(std::move(*file));
+	corpus.m_record_count = *record_count;
+	corpus.m_index = corpus.m_file.data().substr(*index_offset);
+	return corpus;
+}
+
+Result<GameRecordView, Error> GameCorpus::record(std::size_t index) const {
+	if (index >= m_record_count)
+		return Error::InvalidGameRecord;
+
+	BinaryReader reader(m_index.substr(index * INDEX_ENTRY_SIZE, INDEX_ENTRY_SIZE));
+	auto offset = *reader.read<std::uint64_t>();
+	auto size = *reader.read<std::uint32_t>();
+
+	// The records are between the header and the index.
+	auto records_end = m_file.data().size() - m_index.size();
+	if (offset < HEADER_SIZE || offset > records_end || size > records_end - offset)
+		return Error::InvalidGameRecord;
+
+	return GameRecordView::from_binary(m_file.data().substr(offset, size));
+}
+
+Result<GameCorpusWriter, Error> GameCorpusWriter::create(std::string const& path) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	// The header is written again with the right values by finish().
+	if (!file || !file.write(header(0, 0).data(), GameCorpus::HEADER_SIZE))
+		return Error::CouldNotWriteFile;
+
+	return GameCorpusWriter(std::move(file));
+}
+
+Result<void, Error> GameCorpusWriter::append(std::string_view binary_record) {
+	if (binary_record.size() > std::numeric_limits<std::uint32_t>::max())
+		return Error::CouldNotWriteFile;
+
+	if (!m_file.write(binary_record.data(), static_cast<std::streamsize>(binary_record.size())))
+		return Error::CouldNotWriteFile;
+
+	BinaryWriter index_writer(m_index);
+	index_writer.write(m_offset);
+	index_writer.write(static_cast<std::uint32_t>(binary_record.size()));
+
+	m_offset += binary_record.size();
+	++m_record_count;
+	return {};
+}
+
+Result<void, Error> GameCorpusWriter::finish() {
+	if (!m_file.write(m_index.data(), static_cast<std::streamsize>(m_index.size())))
+		return Error::CouldNotWriteFile;
+
+	auto header_data = header(m_record_count, m_offset);
+	if (!m_file.seekp(0) || !m_file.write(header_data.data(), static_cast<std::streamsize>(header_data.size())) || !m_file.flush())
+		return Error::CouldNotWriteFile;
+
+	m_file.close();
+	return {};
+}
+
+}
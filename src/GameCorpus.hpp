@@ -0,0 +1,102 @@
+#pragma once
+
+#include "GameRecord.hpp"
+#include "utils/MappedFile.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+/// \file GameCorpus.hpp
+/// \brief The file that contains the definitions of the \ref Cluedo::GameCorpus and \ref Cluedo::GameCorpusWriter classes.
+
+namespace Cluedo {
+
+/// \brief A corpus of game records in the binary format, packed in a single file behind an index.
+///
+/// The file is mapped into memory and the records are read in place through
+/// \ref Cluedo::GameRecordView, so even corpora of millions of games are
+/// opened in constant time and can be read by many threads at once.
+///
+/// The file is made of, with every integer little-endian:
+/// * the magic `CLGC`, the version of the format (1 byte) and 3 bytes of padding;
+/// * the number of records (8 bytes) and the offset of the index (8 bytes);
+/// * the records, one after the other;
+/// * the index, which has the offset (8 bytes) and the size (4 bytes) of each record.
+class GameCorpus {
+public:
+	static constexpr std::uint8_t VERSION = 1; ///< The version of the format.
+
+	/// Opens a corpus.
+	///
+	/// \param path The path of the corpus.
+	///
+	/// \return A \ref Result object that contains the corpus if it could be
+	/// opened, \ref Cluedo::Error::CouldNotOpenFile if the file couldn't be
+	/// read or \ref Cluedo::Error::InvalidGameCorpus if it isn't a valid corpus.
+	static Result<GameCorpus, Error> open(std::string const& path);
+
+	/// Returns the number of records in the corpus.
+	std::size_t record_count() const { return m_record_count; }
+
+	/// Returns a record of the corpus.
+	///
+	/// \param index The index of the record.
+	///
+	/// \return A \ref Result object that contains the view of the record, which
+	/// is valid as long as the corpus is, or \ref Cluedo::Error::InvalidGameRecord
+	/// if the record isn't valid.
+	Result<GameRecordView, Error> record(std::size_t index) const;
+
+private:
+	static constexpr std::size_t HEADER_SIZE = 24;
+	static constexpr std::size_t INDEX_ENTRY_SIZE = 12;
+
+	friend class GameCorpusWriter;
+
+	explicit GameCorpus(MappedFile&& file)
+	  : m_file(std::move(file)) {}
+
+	MappedFile m_file;
+	std::size_t m_record_count { 0 };
+	std::string_view m_index;
+};
+
+/// \brief A class that writes a \ref Cluedo::GameCorpus, a record at a time.
+class GameCorpusWriter {
+public:
+	/// Creates a new corpus, replacing the file if it exists.
+	///
+	/// \param path The path of the corpus.
+	///
+	/// \return A \ref Result object that contains the writer or
+	/// \ref Cluedo::Error::CouldNotWriteFile if the file couldn't be created.
+	static Result<GameCorpusWriter, Error> create(std::string const& path);
+
+	/// Appends a record to the corpus.
+	///
+	/// \param binary_record The record, in the binary format (see \ref Cluedo::GameRecord::to_binary).
+	///
+	/// \return A \ref Result object that contains nothing if the record was
+	/// written or \ref Cluedo::Error::CouldNotWriteFile otherwise.
+	Result<void, Error> append(std::string_view binary_record);
+
+	/// Writes the index, after which the corpus is complete.
+	/// \note Nothing can be appended after this.
+	///
+	/// \return A \ref Result object that contains nothing if the index was
+	/// written or \ref Cluedo::Error::CouldNotWriteFile otherwise.
+	Result<void, Error> finish();
+
+private:
+	explicit GameCorpusWriter(std::ofstream&& file)
+	  : m_file(std::move(file)) {}
+
+	std::ofstream m_file;
+	std::uint64_t m_offset { GameCorpus::HEADER_SIZE };
+	std::string m_index;
+	std::uint64_t m_record_count { 0 };
+};
+
+}
@@ -0,0 +1,121 @@
+#include "GameLog.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+namespace Cluedo {
+
+GameLog::GameLog(Solver&& solver)
+  : m_solver(std::move(solver)) {
+	assert(m_solver.undo_step_count() == 0);
+	m_snapshots.push_back(m_solver.snapshot());
+}
+
+bool GameLog::append(Solver::Information const& information) {
+	return append(std::span { &information, 1 }) == 1;
+}
+
+std::size_t GameLog::append(std::span<Solver::Information const> informations) {
+	auto appended_count = replay(m_solver, m_informations.size(), informations, &m_snapshots);
+	m_informations.insert(m_informations.end(), informations.begin(), informations.begin() + static_cast<ssize_t>(appended_count));
+	return appended_count;
+}
+
+bool GameLog::replace(std::size_t index, Solver::Information const& information) {
+	auto old_information = std::exchange(m_informations.at(index), information);
+	if (rewrite(index))
+		return true;
+
+	m_informations[index] = std::move(old_information);
+	return false;
+}
+
+bool GameLog::remove(std::size_t index) {
+	auto old_information = std::move(m_informations.at(index));
+	m_informations.erase(m_informations.begin() + static_cast<ssize_t>(index));
+	if (rewrite(index))
+		return true;
+
+	m_informations.insert(m_informations.begin() + static_cast<ssize_t>(index), std::move(old_information));
+	return false;
+}
+
+void GameLog::remove_last() {
+	assert(!m_informations.empty());
+
+	m_informations.pop_back();
+	m_snapshots.erase(m_snapshots.begin() + static_cast<ssize_t>(m_informations.size() / SNAPSHOT_INTERVAL + 1), m_snapshots.end());
+
+	// The undo steps are dropped whenever a snapshot is taken, in that case the
+	// solver is replayed from the previous one.
+	if (m_solver.undo_step_count() > 0)
+		m_solver.undo();
+	else
+		m_solver = solver_after(m_informations.size());
+}
+
+std::size_t GameLog::memory_usage() const {
+	// The solver is counted by its own estimate, which includes the size of the object.
+	auto usage = sizeof(GameLog) - sizeof(Solver) + m_solver.memory_usage();
+	usage += m_informations.capacity() * sizeof(Solver::Information);
+	usage += (m_snapshots.capacity() - m_snapshots.size()) * sizeof(Solver);
+	for (auto const& snapshot : m_snapshots)
+		usage += snapshot.memory_usage();
+
+	return usage;
+}
+
+Solver GameLog::solver_after(std::size_t information_count) const {
+	auto snapshot_index = information_count / SNAPSHOT_INTERVAL;
+	auto solver = m_snapshots.at(snapshot_index).snapshot();
+	auto learnt_count = snapshot_index * SNAPSHOT_INTERVAL;
+
+	[[maybe_unused]] auto replayed_count = replay(solver, learnt_count, std::span(m_informations).subspan(learnt_count, information_count - learnt_count), nullptr);
+	assert(replayed_count == information_count - learnt_count);
+	return solver;
+}
+
+std::size_t GameLog::replay(Solver& solver, std::size_t learnt_count, std::span<Solver::Information const> informations, std::vector<Solver>* snapshots) {
+	std::size_t replayed_count = 0;
+	while (replayed_count < informations.size()) {
+		// The information is learnt in batches that end where the next snapshot has to be taken.
+		auto batch_size = std::min(SNAPSHOT_INTERVAL - learnt_count % SNAPSHOT_INTERVAL, informations.size() - replayed_count);
+		auto batch_learnt_count = solver.learn_in_transactions(informations.subspan(replayed_count, batch_size));
+		replayed_count += batch_learnt_count;
+		learnt_count += batch_learnt_count;
+		if (batch_learnt_count != batch_size)
+			break;
+
+		if (snapshots != nullptr && learnt_count % SNAPSHOT_INTERVAL == 0) {
+			snapshots->push_back(solver.snapshot());
+			solver.clear_undo_steps();
+		}
+	}
+
+	return replayed_count;
+}
+
+bool GameLog::rewrite(std::size_t first_changed_index) {
+	auto snapshot_index = first_changed_index / SNAPSHOT_INTERVAL;
+	auto solver = m_snapshots.at(snapshot_index).snapshot();
+
+	// The snapshots taken after the change are set aside, so that they can be put back if the replay fails.
+	auto first_stale_snapshot = m_snapshots.begin() + static_cast<ssize_t>(snapshot_index + 1);
+	std::vector<Solver> stale_snapshots(std::make_move_iterator(first_stale_snapshot), std::make_move_iterator(m_snapshots.end()));
+	m_snapshots.erase(first_stale_snapshot, m_snapshots.end());
+
+	auto learnt_count = snapshot_index * SNAPSHOT_INTERVAL;
+	auto informations_to_replay = std::span(m_informations).subspan(learnt_count);
+	if (replay(solver, learnt_count, informations_to_replay, &m_snapshots) != informations_to_replay.size()) {
+		m_snapshots.erase(m_snapshots.begin() + static_cast<ssize_t>(snapshot_index + 1), m_snapshots.end());
+		m_snapshots.insert(m_snapshots.end(), std::make_move_iterator(stale_snapshots.begin()), std::make_move_iterator(stale_snapshots.end()));
+		return false;
+	}
+
+	m_solver = std::move(solver);
+	return true;
+}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Solver.hpp"
+
+#include <span>
+#include <vector>
+
+/// \file GameLog.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::GameLog class.
+
+namespace Cluedo {
+
+/// \brief The log of the information learnt during a game.
+///
+/// The log is the source of truth of a game: it stores the information in the
+/// order it was learnt and the \ref Cluedo::Solver is just a projection of it.
+/// New information is appended to the log, while changing or removing
+/// information learnt earlier rewrites the log from that point on.
+///
+/// Every \ref SNAPSHOT_INTERVAL pieces of information a snapshot of the solver
+/// is stored and its undo steps are dropped, so that replaying the log from
+/// any point only needs to replay the information after the closest snapshot
+/// and the undo steps never take more memory than the ones of a single interval.
+class GameLog {
+public:
+	static constexpr std::size_t SNAPSHOT_INTERVAL = 16; ///< The number of pieces of information between two snapshots.
+
+	/// Constructs the log of a new game.
+	///
+	/// \param solver The solver of the game, which must not have learnt anything yet.
+	explicit GameLog(Solver&& solver);
+
+	/// Returns the information in the log.
+	///
+	/// \return The information in the log, in the order it was learnt.
+	std::span<Solver::Information const> informations() const { return m_informations; }
+	/// Returns the solver with all the information in the log learnt.
+	///
+	/// \return The solver with all the information in the log learnt.
+	Solver const& solver() const { return m_solver; }
+
+	/// Appends a piece of information to the log.
+	/// \note If the information isn't valid the log is left untouched.
+	///
+	/// \param information The information to append.
+	///
+	/// \return `true` if the information was appended, `false` otherwise.
+	bool append(Solver::Information const& information);
+	/// Appends a sequence of information to the log.
+	/// \note This method stops at the first information that isn't valid.
+	///
+	/// \param informations The information to append.
+	///
+	/// \return The number of information appended.
+	std::size_t append(std::span<Solver::Information const> informations);
+	/// Replaces a piece of information of the log.
+	/// \note If the information isn't valid the log is left untouched.
+	///
+	/// \param index The index of the information to replace.
+	/// \param information The new information.
+	///
+	/// \return `true` if the information was replaced, `false` otherwise.
+	bool replace(std::size_t index, Solver::Information const& information);
+	/// Removes a piece of information from the log.
+	///
+	/// \param index The index of the information to remove.
+	///
+	/// \return `true` if the information was removed, `false` if the
+	/// information after it isn't valid anymore and the log was left untouched.
+	bool remove(std::size_t index);
+	/// Removes the last piece of information from the log.
+	/// \note This method will fail if the log is empty.
+	void remove_last();
+
+	/// Returns the solver as it was after some information was learnt.
+	///
+	/// \param information_count The number of information learnt.
+	///
+	/// \return The solver after the first \a information_count pieces of information were learnt.
+	Solver solver_after(std::size_t information_count) const;
+
+	/// Returns an estimate of the memory used by the log.
+	///
+	/// \return The number of bytes used by the log, including its snapshots and its solver.
+	std::size_t memory_usage() const;
+
+private:
+	static std::size_t replay(Solver&, std::size_t learnt_count, std::span<Solver::Information const>, std::vector<Solver>* snapshots);
+	// Replays the log from the snapshot before the information that changed, leaving the snapshots and the solver untouched if it fails.
+	bool rewrite(std::size_t first_changed_index);
+
+	std::vector<Solver::Information> m_informations;
+	std::vector<Solver> m_snapshots;
+	Solver m_solver;
+};
+
+}
@@ -0,0 +1,220 @@
+#include "GameRecord.hpp"
+
+#include "JsonUtils.hpp"
+#include "utils/BinaryStream.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace std::literals;
+
+namespace Cluedo {
+
+static constexpr auto BINARY_MAGIC = "CLGR"sv;
+static constexpr std::uint32_t NO_RESPONDING_PLAYER = 7;
+
+static std::uint32_t card_index_in_category(Card card) {
+	return static_cast<std::uint32_t>(card) - static_cast<std::uint32_t>(CardUtils::card_category(card));
+}
+
+static std::optional<Card> card_from_index_in_category(CardCategory category, std::uint32_t index) {
+	auto card = static_cast<std::uint32_t>(category) + index;
+	if (card >= CardUtils::CARD_COUNT || CardUtils::card_category(static_cast<Card>(card)) != category)
+		return std::nullopt;
+
+	return static_cast<Card>(card);
+}
+
+static std::optional<std::uint32_t> encode_information(Solver::Information const& information) {
+	if (auto const* player_card_state = std::get_if<Solver::PlayerCardState>(&information)) {
+		if (player_card_state->player_index >= Solver::MAX_PLAYER_COUNT)
+			return std::nullopt;
+
+		return static_cast<std::uint32_t>(player_card_state->player_index) << 1 | static_cast<std::uint32_t>(player_card_state->has_card) << 4 | static_cast<std::uint32_t>(player_card_state->card) << 5;
+	}
+
+	auto const& suggestion = std::get<Solver::Suggestion>(information);
+	if (!Solver::is_valid_suggestion(suggestion, Solver::MAX_PLAYER_COUNT))
+		return std::nullopt;
+
+	std::uint32_t response_card = 0;
+	if (suggestion.response_card) {
+		std::array cards { suggestion.suspect, suggestion.weapon, suggestion.room };
+		response_card = static_cast<std::uint32_t>(std::find(cards.begin(), cards.end(), *suggestion.response_card) - cards.begin()) + 1;
+	}
+
+	return 1
+	  | static_cast<std::uint32_t>(suggestion.suggesting_player_index) << 1
+	  | static_cast<std::uint32_t>(suggestion.responding_player_index.value_or(NO_RESPONDING_PLAYER)) << 4
+	  | card_index_in_category(suggestion.suspect) << 7
+	  | card_index_in_category(suggestion.weapon) << 10
+	  | card_index_in_category(suggestion.room) << 13
+	  | response_card << 17;
+}
+
+static std::uint32_t read_information_bits(std::string_view informations, std::size_t index) {
+	BinaryReader reader(informations.substr(index * GameRecordView::BINARY_INFORMATION_SIZE, GameRecordView::BINARY_INFORMATION_SIZE));
+	return *reader.read<std::uint16_t>() | static_cast<std::uint32_t>(*reader.read<std::uint8_t>()) << 16;
+}
+
+static std::optional<Solver::Information> decode_information(std::uint32_t bits, std::size_t player_count) {
+	auto field = [bits](unsigned offset, unsigned size) { return (bits >> offset) & ((1u << size) - 1); };
+
+	if (field(0, 1) == 0) {
+		auto player_index = field(1, 3);
+		auto card = field(5, 5);
+		if (player_index >= player_count || card >= CardUtils::CARD_COUNT || bits >> 10 != 0)
+			return std::nullopt;
+
+		return Solver::PlayerCardState { player_index, static_cast<Card>(card), field(4, 1) == 1 };
+	}
+
+	auto suggesting_player_index = field(1, 3);
+	auto responding_player_index = field(4, 3);
+	auto suspect = card_from_index_in_category(CardCategory::Suspect, field(7, 3));
+	auto weapon = card_from_index_in_category(CardCategory::Weapon, field(10, 3));
+	auto room = card_from_index_in_category(CardCategory::Room, field(13, 4));
+	auto response_card = field(17, 2);
+	if (suggesting_player_index >= player_count || (responding_player_index != NO_RESPONDING_PLAYER && responding_player_index >= player_count) || !suspect || !weapon || !room || bits >> 19 != 0)
+		return std::nullopt;
+
+	Solver::Suggestion suggestion { suggesting_player_index, *suspect, *weapon, *room, std::nullopt, std::nullopt };
+	if (responding_player_index != NO_RESPONDING_PLAYER)
+		suggestion.responding_player_index = responding_player_index;
+
+	if (response_card != 0)
+		suggestion.response_card = std::array { *suspect, *weapon, *room }[response_card - 1];
+
+	if (!Solver::is_valid_suggestion(suggestion, player_count))
+		return std::nullopt;
+
+	return suggestion;
+}
+
+Result<GameRecord, Error> GameRecord::from_json(std::string_view document) {
+	auto object = Json::parse(document, nullptr, false);
+	if (object.is_discarded() || !object.is_object() || !object.contains("players") || !object.contains("informations") || !object["informations"].is_array())
+		return Error::InvalidGameRecord;
+
+	auto players = JsonUtils::players_from_json(object["players"]);
+	if (!players)
+		return Error::InvalidGameRecord;
+
+	GameRecord record { std::move(*players), {} };
+	for (auto const& information : object["informations"]) {
+		auto maybe_information = JsonUtils::information_from_json(information, record.players.size());
+		if (!maybe_information)
+			return Error::InvalidGameRecord;
+
+		record.informations.push_back(*maybe_information);
+	}
+
+	return record;
+}
+
+std::string GameRecord::to_json() const {
+	Json object { { "players", JsonUtils::players_to_json(players) }, { "informations", Json::array() } };
+	for (auto const& information : informations)
+		object["informations"].push_back(JsonUtils::information_to_json(information));
+
+	return object.dump();
+}
+
+Result<GameRecord, Error> GameRecord::from_binary(std::string_view data) {
+	auto view = TRY(GameRecordView::from_binary(data));
+	return view.to_record();
+}
+
+Result<std::string, Error> GameRecord::to_binary() const {
+	if (players.size() > Solver::MAX_PLAYER_COUNT || informations.size() > std::numeric_limits<std::uint32_t>::max())
+		return Error::InvalidGameRecord;
+
+	std::string data;
+	data.reserve(BINARY_MAGIC.size() + 2 + players.size() * 2 + 4 + informations.size() * GameRecordView::BINARY_INFORMATION_SIZE);
+
+	BinaryWriter writer(data);
+	writer.write_bytes(BINARY_MAGIC);
+	writer.write(GameRecordView::BINARY_VERSION);
+	writer.write(static_cast<std::uint8_t>(players.size()));
+	for (auto const& player : players) {
+		if (player.card_count > CardUtils::CARD_COUNT || player.name.size() > std::numeric_limits<std::uint8_t>::max())
+			return Error::InvalidGameRecord;
+
+		writer.write(static_cast<std::uint8_t>(player.card_count));
+		writer.write(static_cast<std::uint8_t>(player.name.size()));
+		writer.write_bytes(player.name);
+	}
+
+	writer.write(static_cast<std::uint32_t>(informations.size()));
+	for (auto const& information : informations) {
+		auto bits = encode_information(information);
+		if (!bits)
+			return Error::InvalidGameRecord;
+
+		writer.write(static_cast<std::uint16_t>(*bits));
+		writer.write(static_cast<std::uint8_t>(*bits >> 16));
+	}
+
+	return data;
+}
+
+Result<GameRecordView, Error> GameRecordView::from_binary(std::string_view data) {
+	if (!is_binary(data))
+		return Error::InvalidGameRecord;
+
+	BinaryReader reader(data.substr(BINARY_MAGIC.size()));
+	auto version = reader.read<std::uint8_t>();
+	auto player_count = reader.read<std::uint8_t>();
+	if (version != BINARY_VERSION || !player_count || *player_count > Solver::MAX_PLAYER_COUNT)
+		return Error::InvalidGameRecord;
+
+	GameRecordView view;
+	view.m_player_count = *player_count;
+	for (std::size_t i = 0; i < view.m_player_count; ++i) {
+		auto card_count = reader.read<std::uint8_t>();
+		auto name_size = reader.read<std::uint8_t>();
+		auto name = name_size ? reader.read_bytes(*name_size) : std::nullopt;
+		if (!card_count || !name)
+			return Error::InvalidGameRecord;
+
+		view.m_players[i] = { *name, *card_count };
+	}
+
+	auto information_count = reader.read<std::uint32_t>();
+	if (!information_count || reader.remaining_size() != static_cast<std::size_t>(*information_count) * BINARY_INFORMATION_SIZE)
+		return Error::InvalidGameRecord;
+
+	view.m_informations = *reader.read_bytes(reader.remaining_size());
+	for (std::size_t i = 0; i < *information_count; ++i) {
+		if (!decode_information(read_information_bits(view.m_informations, i), view.m_player_count))
+			return Error::InvalidGameRecord;
+	}
+
+	return view;
+}
+
+bool GameRecordView::is_binary(std::string_view data) {
+	return data.starts_with(BINARY_MAGIC);
+}
+
+Solver::Information GameRecordView::information(std::size_t index) const {
+	assert(index < information_count());
+
+	// The information was checked when the view was created.
+	return *decode_information(read_information_bits(m_informations, index), m_player_count);
+}
+
+GameRecord GameRecordView::to_record() const {
+	GameRecord record;
+	for (std::size_t i = 0; i < m_player_count; ++i)
+		record.players.push_back({ std::string(m_players[i].name), m_players[i].card_count });
+
+	record.informations.reserve(information_count());
+	for (std::size_t i = 0; i < information_count(); ++i)
+		record.informations.push_back(information(i));
+
+	return record;
+}
+
+}
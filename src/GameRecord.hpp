@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Solver.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \file GameRecord.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::GameRecord struct.
+
+namespace Cluedo {
+
+/// \brief The record of a game: its players and the information learnt, in order.
+///
+/// Records are stored as JSON documents like this one:
+/// ```json
+/// {
+///   "players": [
+///     { "name": "Alice", "card_count": 6 },
+///     { "name": "Bob", "card_count": 6 },
+///     { "name": "Carol", "card_count": 6 }
+///   ],
+///   "informations": [
+///     { "type": "player_card_state", "player": 0, "card": "Knife", "has_card": true },
+///     { "type": "suggestion", "player": 1, "suspect": "Green", "weapon": "Rope", "room": "Kitchen", "responding_player": 2, "response_card": "Rope" }
+///   ]
+/// }
+/// ```
+/// The cards are named as by \ref format_as(Card), while `responding_player`
+/// and `response_card` are left out or `null` when they aren't known.
+///
+/// Records can also be stored in a compact binary format, where every integer
+/// is little-endian:
+/// * the magic `CLGR` and the version of the format (1 byte);
+/// * the number of players (1 byte) and, for each player, its number of cards
+///   (1 byte), the length of its name (1 byte) and the UTF-8 name;
+/// * the number of information (4 bytes) and the information, 3 bytes each.
+///
+/// Every piece of information is a 24-bit integer: the lowest bit is 0 for a
+/// \ref Cluedo::Solver::PlayerCardState, followed by the player (3 bits),
+/// `has_card` (1 bit) and the card (5 bits), or 1 for a
+/// \ref Cluedo::Solver::Suggestion, followed by the suggesting player
+/// (3 bits), the responding player (3 bits, 7 if no one responded), the
+/// suspect, the weapon and the room as indices in their category (3, 3 and
+/// 4 bits) and which of them was the response card (2 bits, 0 if unknown).
+/// Since the information has a fixed size it can be read in place, see
+/// \ref Cluedo::GameRecordView.
+struct GameRecord {
+	std::vector<PlayerData> players;               ///< The players of the game.
+	std::vector<Solver::Information> informations; ///< The information learnt, in the order it was learnt.
+
+	/// Parses a game record from a JSON document.
+	///
+	/// \param json The JSON document.
+	///
+	/// \return A \ref Result object that contains the record if the document is
+	/// valid or \ref Cluedo::Error::InvalidGameRecord otherwise.
+	static Result<GameRecord, Error> from_json(std::string_view json);
+
+	/// Converts the record into a JSON document.
+	///
+	/// \return The JSON document.
+	std::string to_json() const;
+
+	/// Parses a game record from the binary format.
+	///
+	/// \param data The binary data.
+	///
+	/// \return A \ref Result object that contains the record if the data is
+	/// valid or \ref Cluedo::Error::InvalidGameRecord otherwise.
+	static Result<GameRecord, Error> from_binary(std::string_view data);
+
+	/// Converts the record into the binary format.
+	/// \note A suggestion can only be converted if it can happen in a game
+	/// (see \ref Cluedo::Solver::is_valid_suggestion).
+	///
+	/// \return A \ref Result object that contains the binary data if the record
+	/// can be converted or \ref Cluedo::Error::InvalidGameRecord otherwise.
+	Result<std::string, Error> to_binary() const;
+};
+
+/// \brief A view of a game record in the binary format, which reads it in place.
+///
+/// The data is checked once when the view is created, then the players and the
+/// information are decoded only when they are asked for, without any allocation.
+class GameRecordView {
+public:
+	static constexpr std::uint8_t BINARY_VERSION = 1;          ///< The version of the binary format.
+	static constexpr std::size_t BINARY_INFORMATION_SIZE = 3; ///< The size in bytes of a piece of information in the binary format.
+
+	/// Creates a view of a game record in the binary format.
+	///
+	/// \param data The binary data, which must outlive the view.
+	///
+	/// \return A \ref Result object that contains the view if the data is
+	/// valid or \ref Cluedo::Error::InvalidGameRecord otherwise.
+	static Result<GameRecordView, Error> from_binary(std::string_view data);
+
+	/// Checks if some data starts like a game record in the binary format.
+	///
+	/// \param data The data.
+	///
+	/// \return `true` if the data starts with the magic of the binary format, `false` otherwise.
+	static bool is_binary(std::string_view data);
+
+	/// Returns the number of players.
+	std::size_t player_count() const { return m_player_count; }
+	/// Returns the name of a player.
+	///
+	/// \param player_index The index of the player.
+	///
+	/// \return The name of the player, which points into the data.
+	std::string_view player_name(std::size_t player_index) const { return m_players.at(player_index).name; }
+	/// Returns the number of cards held by a player.
+	///
+	/// \param player_index The index of the player.
+	///
+	/// \return The number of cards held by the player.
+	std::size_t player_card_count(std::size_t player_index) const { return m_players.at(player_index).card_count; }
+
+	/// Returns the number of information in the record.
+	std::size_t information_count() const { return m_informations.size() / BINARY_INFORMATION_SIZE; }
+	/// Decodes a piece of information.
+	///
+	/// \param index The index of the information.
+	///
+	/// \return The information.
+	Solver::Information information(std::size_t index) const;
+
+	/// Copies the record out of the view.
+	///
+	/// \return The record.
+	GameRecord to_record() const;
+
+private:
+	struct Player {
+		std::string_view name;
+		std::size_t card_count;
+	};
+
+	GameRecordView() = default;
+
+	std::array<Player, Solver::MAX_PLAYER_COUNT> m_players {};
+	std::size_t m_player_count { 0 };
+	std::string_view m_informations;
+};
+
+}
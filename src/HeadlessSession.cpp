@@ -0,0 +1,157 @@
+#include "HeadlessSession.hpp"
+
+#include <string>
+
+using namespace std::literals;
+
+namespace Cluedo {
+
+static Json error_response(Error error) {
+	return { { "ok", false }, { "error", format_as(error) } };
+}
+
+HeadlessSession::HeadlessSession(SolverPool& solver_pool, std::size_t max_memory_usage, std::size_t max_pending_solve_count)
+  : m_solver_pool(solver_pool), m_max_memory_usage(max_memory_usage), m_max_pending_solve_count(max_pending_solve_count) {
+}
+
+HeadlessSession::~HeadlessSession() {
+	m_solve_state->stop_source.request_stop();
+}
+
+void HeadlessSession::handle_request(std::string_view line, Respond const& respond) {
+	if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+		return;
+
+	handle_request(Json::parse(line, nullptr, false), respond);
+}
+
+void HeadlessSession::handle_request(Json const& request, Respond const& respond) {
+	bool is_valid = !request.is_discarded() && request.is_object() && request.contains("command") && request["command"].is_string();
+	auto result = is_valid ? handle_command(request["command"].get_ref<std::string const&>(), request, respond) : error_response(Error::InvalidRequest);
+	// The response of a solve is given when the solve is over.
+	if (result.is_null())
+		return;
+
+	Json response { { "id", request.is_object() && request.contains("id") ? request["id"] : Json() } };
+	response.update(result);
+	respond(std::move(response));
+}
+
+Json HeadlessSession::handle_command(std::string_view command, Json const& request, Respond const& respond) {
+	if (command == "new_game"sv) {
+		auto players = request.contains("players") ? JsonUtils::players_from_json(request["players"]) : std::nullopt;
+		if (!players)
+			return error_response(Error::InvalidRequest);
+
+		auto maybe_solver = Solver::create(*players);
+		if (maybe_solver.is_error())
+			return error_response(maybe_solver.release_error());
+
+		GameLog game_log(maybe_solver.release_value());
+		if (request.contains("informations")) {
+			if (!request["informations"].is_array())
+				return error_response(Error::InvalidRequest);
+
+			for (auto const& information : request["informations"]) {
+				auto maybe_information = JsonUtils::information_from_json(information, players->size());
+				if (!maybe_information)
+					return error_response(Error::InvalidRequest);
+
+				if (!game_log.append(*maybe_information))
+					return error_response(Error::InvalidInformation);
+
+				if (game_log.memory_usage() > m_max_memory_usage)
+					return error_response(Error::MemoryLimitExceeded);
+			}
+		}
+
+		m_game_log.emplace(std::move(game_log));
+		return { { "ok", true }, { "information_count", m_game_log->informations().size() } };
+	}
+
+	if (!m_game_log)
+		return error_response(Error::NoGameInProgress);
+
+	if (command == "learn"sv) {
+		auto maybe_information = request.contains("information") ? JsonUtils::information_from_json(request["information"], m_game_log->solver().player_count()) : std::nullopt;
+		if (!maybe_information)
+			return error_response(Error::InvalidRequest);
+
+		if (!m_game_log->append(*maybe_information))
+			return error_response(Error::InvalidInformation);
+
+		if (m_game_log->memory_usage() > m_max_memory_usage) {
+			m_game_log->remove_last();
+			return error_response(Error::MemoryLimitExceeded);
+		}
+
+		return { { "ok", true }, { "information_count", m_game_log->informations().size() } };
+	}
+
+	if (command == "undo"sv) {
+		if (m_game_log->informations().empty())
+			return error_response(Error::InvalidRequest);
+
+		m_game_log->remove_last();
+		return { { "ok", true }, { "information_count", m_game_log->informations().size() } };
+	}
+
+	if (command == "snapshot"sv) {
+		auto const& solver = m_game_log->solver();
+		std::vector<PlayerData> players;
+		for (std::size_t i = 0; i < solver.player_count(); ++i)
+			players.push_back({ solver.player(i).name(), solver.player(i).card_count() });
+
+		Json informations = Json::array();
+		for (auto const& information : m_game_log->informations())
+			informations.push_back(JsonUtils::information_to_json(information));
+
+		return { { "ok", true }, { "record", { { "players", JsonUtils::players_to_json(players) }, { "informations", std::move(informations) } } } };
+	}
+
+	if (command == "solve"sv) {
+		{
+			std::lock_guard lock(m_solve_state->mutex);
+			if (m_solve_state->pending_solve_count >= m_max_pending_solve_count)
+				return error_response(Error::TooManyPendingSolves);
+
+			++m_solve_state->pending_solve_count;
+		}
+
+		auto id = request.contains("id") ? request["id"] : Json();
+		// The solve only refers to the shared state, since it can be over after the session was destroyed.
+		m_solver_pool.submit(m_game_log->solver().snapshot(), m_solve_state->stop_source.get_token(), [solve_state = m_solve_state, id = std::move(id), respond](std::vector<Solver::SolutionProbabilityPair>&& solutions, SolveProgress const& progress, bool is_stopped) {
+			// A solve stopped because the session was destroyed has no response, while
+			// one stopped or dropped because the pool is destroyed is reported as cancelled.
+			if (!solve_state->stop_source.stop_requested()) {
+				Json response { { "id", id } };
+				if (is_stopped) {
+					response.update(error_response(Error::SolveCancelled));
+				} else {
+					response.update({ { "ok", true }, { "sample_count", progress.sample_count() } });
+					response.update(JsonUtils::estimate_to_json(solutions, progress.card_ownership_probabilities()));
+				}
+				respond(std::move(response));
+			}
+
+			std::lock_guard lock(solve_state->mutex);
+			--solve_state->pending_solve_count;
+			solve_state->idle_condition.notify_all();
+		});
+		return nullptr;
+	}
+
+	return error_response(Error::InvalidRequest);
+}
+
+std::size_t HeadlessSession::pending_solve_count() {
+	std::lock_guard lock(m_solve_state->mutex);
+	return m_solve_state->pending_solve_count;
+}
+
+void HeadlessSession::wait() {
+	std::unique_lock lock(m_solve_state->mutex);
+	m_solve_state->idle_condition.wait(lock, [this] { return m_solve_state->pending_solve_count == 0; });
+}
+
+}
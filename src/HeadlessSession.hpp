@@ -0,0 +1,109 @@
+#pragma once
+
+#include "GameLog.hpp"
+#include "JsonUtils.hpp"
+#include "SolverPool.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string_view>
+
+/// \file HeadlessSession.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::HeadlessSession class.
+
+namespace Cluedo {
+
+/// \brief A session that drives the solver through JSON requests, without any display.
+///
+/// Every request is a JSON object on its own line, with a `command` and an
+/// optional `id` which is copied as it is into the response, so that the
+/// responses can be matched with the requests. The commands are:
+/// * `new_game`: starts a game with the given `players` (see \ref Cluedo::JsonUtils::players_from_json)
+///   and, optionally, learns the given `informations`;
+/// * `learn`: learns the given `information` (see \ref Cluedo::JsonUtils::information_from_json);
+/// * `undo`: forgets the last information learnt;
+/// * `snapshot`: returns the `record` of the game, which can be given back to `new_game`;
+/// * `solve`: finds the most likely solutions of the game as it is now (see \ref Cluedo::JsonUtils::estimate_to_json).
+///
+/// Every response has `ok` set to `true` if the request succeeded or to
+/// `false` along with an `error` otherwise. The responses of all the commands
+/// but `solve` are given before the next request is handled, while the solves
+/// run on the threads of a \ref Cluedo::SolverPool and their responses are
+/// given as soon as they are over, so requests can be pipelined without
+/// waiting for the solves.
+///
+/// The memory used by the game of the session can be capped, in which case
+/// the information that would exceed the cap is rejected with
+/// \ref Cluedo::Error::MemoryLimitExceeded. Since every solve waiting for a
+/// thread keeps its own copy of the solver, the number of solves of the session
+/// that aren't over can be capped too, in which case the solves that would
+/// exceed the cap are rejected with \ref Cluedo::Error::TooManyPendingSolves.
+/// The solves that are stopped or dropped because the pool is destroyed are
+/// answered with \ref Cluedo::Error::SolveCancelled.
+class HeadlessSession {
+public:
+	/// \typedef Respond
+	/// \brief The function that gives the response to a request.
+	/// \note It's called from the threads of the pool for the solves, so it must be thread-safe.
+	using Respond = std::function<void(Json&&)>;
+
+	/// Constructs the session.
+	///
+	/// \param solver_pool The pool on which the solves are run, which must not be destroyed while the session handles a request.
+	/// \param max_memory_usage The maximum number of bytes the game of the session can use (see \ref Cluedo::GameLog::memory_usage).
+	/// \param max_pending_solve_count The maximum number of solves of the session that can be requested but not over yet.
+	explicit HeadlessSession(SolverPool& solver_pool, std::size_t max_memory_usage = std::numeric_limits<std::size_t>::max(), std::size_t max_pending_solve_count = std::numeric_limits<std::size_t>::max());
+	/// Destroys the session, stopping its solves.
+	/// \note The stopped solves have no response. The session doesn't wait for
+	/// them: the solves still in the queue of the pool only keep the state they
+	/// share with the session alive until the pool gets to them and drops them.
+	~HeadlessSession();
+
+	HeadlessSession(HeadlessSession const&) = delete;
+	HeadlessSession& operator=(HeadlessSession const&) = delete;
+
+	/// Handles a request.
+	/// \note Empty lines are ignored.
+	///
+	/// \param line The line of the request.
+	/// \param respond The function that gives the response to the request.
+	void handle_request(std::string_view line, Respond const& respond);
+	/// Handles a request that was already parsed.
+	///
+	/// \param request The request.
+	/// \param respond The function that gives the response to the request.
+	void handle_request(Json const& request, Respond const& respond);
+
+	/// Returns the number of solves that were requested but are not over yet.
+	///
+	/// \return The number of solves that were requested but are not over yet.
+	std::size_t pending_solve_count();
+	/// Waits until all the solves requested so far are over and their responses were given.
+	void wait();
+
+private:
+	Json handle_command(std::string_view command, Json const& request, Respond const& respond);
+
+	SolverPool& m_solver_pool;
+	std::size_t m_max_memory_usage;
+	std::size_t m_max_pending_solve_count;
+
+	std::optional<GameLog> m_game_log;
+
+	// The state shared with the solves, which outlives the session until they are all over.
+	struct SolveState {
+		std::stop_source stop_source;
+		std::mutex mutex;
+		std::condition_variable idle_condition;
+		std::size_t pending_solve_count { 0 };
+	};
+
+	std::shared_ptr<SolveState> m_solve_state { std::make_shared<SolveState>() };
+};
+
+}
@@ -0,0 +1,149 @@
+#include "JsonUtils.hpp"
+
+#include <string>
+
+namespace Cluedo {
+
+static std::optional<Card> card_from_json(Json const& object, char const* key) {
+	auto it = object.find(key);
+	if (it == object.end() || !it->is_string())
+		return std::nullopt;
+
+	return CardUtils::card_from_name(it->get<std::string_view>());
+}
+
+static std::optional<std::size_t> index_from_json(Json const& object, char const* key) {
+	auto it = object.find(key);
+	if (it == object.end() || !it->is_number_unsigned())
+		return std::nullopt;
+
+	return it->get<std::size_t>();
+}
+
+std::optional<std::vector<PlayerData>> JsonUtils::players_from_json(Json const& array) {
+	if (!array.is_array())
+		return std::nullopt;
+
+	std::vector<PlayerData> players;
+	for (auto const& player : array) {
+		if (!player.is_object())
+			return std::nullopt;
+
+		auto card_count = index_from_json(player, "card_count");
+		if (!card_count)
+			return std::nullopt;
+
+		std::string name;
+		if (player.contains("name")) {
+			if (!player["name"].is_string())
+				return std::nullopt;
+
+			name = player["name"].get<std::string>();
+		}
+
+		players.push_back({ std::move(name), *card_count });
+	}
+
+	return players;
+}
+
+Json JsonUtils::players_to_json(std::span<PlayerData const> players) {
+	Json array = Json::array();
+	for (auto const& player : players)
+		array.push_back({ { "name", player.name }, { "card_count", player.card_count } });
+
+	return array;
+}
+
+std::optional<Solver::Information> JsonUtils::information_from_json(Json const& object, std::size_t player_count) {
+	if (!object.is_object() || !object.contains("type") || !object["type"].is_string())
+		return std::nullopt;
+
+	auto player_index = index_from_json(object, "player");
+	if (!player_index || *player_index >= player_count)
+		return std::nullopt;
+
+	auto const& type = object["type"].get_ref<std::string const&>();
+	if (type == "player_card_state") {
+		auto card = card_from_json(object, "card");
+		if (!card || !object.contains("has_card") || !object["has_card"].is_boolean())
+			return std::nullopt;
+
+		return Solver::PlayerCardState { *player_index, *card, object["has_card"].get<bool>() };
+	}
+
+	if (type == "suggestion") {
+		auto suspect = card_from_json(object, "suspect");
+		auto weapon = card_from_json(object, "weapon");
+		auto room = card_from_json(object, "room");
+		if (!suspect || !weapon || !room)
+			return std::nullopt;
+
+		Solver::Suggestion suggestion { *player_index, *suspect, *weapon, *room, std::nullopt, std::nullopt };
+		if (object.contains("responding_player") && !object["responding_player"].is_null()) {
+			suggestion.responding_player_index = index_from_json(object, "responding_player");
+			if (!suggestion.responding_player_index || *suggestion.responding_player_index >= player_count)
+				return std::nullopt;
+		}
+
+		if (object.contains("response_card") && !object["response_card"].is_null()) {
+			suggestion.response_card = card_from_json(object, "response_card");
+			if (!suggestion.response_card)
+				return std::nullopt;
+		}
+
+		if (!Solver::is_valid_suggestion(suggestion, player_count))
+			return std::nullopt;
+
+		return suggestion;
+	}
+
+	return std::nullopt;
+}
+
+Json JsonUtils::information_to_json(Solver::Information const& information) {
+	if (auto const* player_card_state = std::get_if<Solver::PlayerCardState>(&information)) {
+		return {
+			{ "type", "player_card_state" },
+			{ "player", player_card_state->player_index },
+			{ "card", format_as(player_card_state->card) },
+			{ "has_card", player_card_state->has_card },
+		};
+	}
+
+	auto const& suggestion = std::get<Solver::Suggestion>(information);
+	Json object {
+		{ "type", "suggestion" },
+		{ "player", suggestion.suggesting_player_index },
+		{ "suspect", format_as(suggestion.suspect) },
+		{ "weapon", format_as(suggestion.weapon) },
+		{ "room", format_as(suggestion.room) },
+	};
+
+	if (suggestion.responding_player_index)
+		object["responding_player"] = *suggestion.responding_player_index;
+	if (suggestion.response_card)
+		object["response_card"] = format_as(*suggestion.response_card);
+
+	return object;
+}
+
+Json JsonUtils::estimate_to_json(std::span<Solver::SolutionProbabilityPair const> solutions, Solver::CardOwnershipProbabilities const& card_ownership) {
+	Json solutions_array = Json::array();
+	for (auto const& [solution, probability] : solutions) {
+		auto [suspect, weapon, room] = solution;
+		solutions_array.push_back({ { "suspect", format_as(suspect) }, { "weapon", format_as(weapon) }, { "room", format_as(room) }, { "probability", probability } });
+	}
+
+	Json card_owners_array = Json::array();
+	for (auto const& owner_probabilities : card_ownership) {
+		Json owner_object = Json::object();
+		for (auto card : CardUtils::cards())
+			owner_object[std::string { format_as(card) }] = owner_probabilities[static_cast<std::size_t>(card)];
+		card_owners_array.push_back(std::move(owner_object));
+	}
+
+	return { { "solutions", std::move(solutions_array) }, { "card_owners", std::move(card_owners_array) } };
+}
+
+}
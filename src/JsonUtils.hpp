@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Solver.hpp"
+
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+/// \file JsonUtils.hpp
+/// \brief The file that contains the conversions between the data of the solver and JSON.
+
+namespace Cluedo {
+
+/// \typedef Json
+/// \brief The JSON value used by the conversions, which keeps the order of the keys.
+using Json = nlohmann::ordered_json;
+
+/// \brief A series of utilities to convert the data of the solver from and to JSON.
+///
+/// The cards are named as by \ref format_as(Card) and the players are
+/// referred to by their index. See \ref Cluedo::GameRecord for an example of
+/// the players and the information.
+struct JsonUtils {
+	/// Converts a list of players from JSON.
+	///
+	/// \param array The array of players, each one with its `card_count` and optionally its `name`.
+	///
+	/// \return The players or `std::nullopt` if the array isn't valid.
+	static std::optional<std::vector<PlayerData>> players_from_json(Json const& array);
+	/// Converts a list of players into JSON.
+	///
+	/// \param players The players.
+	///
+	/// \return The array of players.
+	static Json players_to_json(std::span<PlayerData const> players);
+
+	/// Converts a piece of information from JSON.
+	///
+	/// \param object The information, with a `type` that is either `player_card_state` or `suggestion`.
+	/// \param player_count The number of players of the game, used to check the indices of the players.
+	///
+	/// \return The information or `std::nullopt` if the object isn't valid,
+	/// which includes the suggestions that can't happen in a game (see \ref Cluedo::Solver::is_valid_suggestion).
+	static std::optional<Solver::Information> information_from_json(Json const& object, std::size_t player_count);
+	/// Converts a piece of information into JSON.
+	///
+	/// \param information The information.
+	///
+	/// \return The object of the information.
+	static Json information_to_json(Solver::Information const& information);
+
+	/// Converts the estimate of a game into JSON.
+	///
+	/// The object has the `solutions`, each one with its `suspect`, `weapon`,
+	/// `room` and `probability`, and the `card_owners`, which has an object for
+	/// each player, and the solution as the last one, with the probability of
+	/// holding each card.
+	///
+	/// \param solutions The solutions ordered by their probability.
+	/// \param card_ownership The probabilities of each player holding each card.
+	///
+	/// \return The object of the estimate.
+	static Json estimate_to_json(std::span<Solver::SolutionProbabilityPair const> solutions, Solver::CardOwnershipProbabilities const& card_ownership);
+};
+
+}
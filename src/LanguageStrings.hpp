@@ -1,7 +1,13 @@
 #pragma once
 
-#include <memory>
-#include <nlohmann/json.hpp>
+#include "Card.hpp"
+#include "Error.hpp"
+#include "lang/langs.hpp"
+
+#include <atomic>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 /// \file LanguageStrings.hpp
 /// \brief The file that contains the definition of the \ref Cluedo::LanguageStrings class.
@@ -9,14 +15,26 @@
 namespace Cluedo {
 
 /// The class that contains the strings of the application which can be translated.
+///
+/// The language files are compiled at build time into a table of strings for
+/// each language, indexed by the \ref Cluedo::StringKey enum, so getting a
+/// string is just an array access and the returned strings are always
+/// null-terminated. The build fails if a language is missing any key.
+///
+/// The tables never change, only the pointer to the current one does and it
+/// is atomic, so strings can be read from any thread without locks.
 /// \note This class is a singleton.
 class LanguageStrings {
 public:
+	/// \typedef Strings
+	/// \brief The table of the strings of a language.
+	using Strings = std::array<std::string_view, STRING_KEY_COUNT>;
+
 	/// \brief A struct that contains the data of a language.
 	struct Language {
-		std::string_view id;   ///< An identifier used for the language.
-		std::string_view name; ///< The name of the language.
-		std::string_view data; ///< The JSON data of the language.
+		std::string_view id;    ///< An identifier used for the language.
+		std::string_view name;  ///< The name of the language.
+		Strings const* strings; ///< The strings of the language.
 	};
 
 	/// Returns the instance of the class.
@@ -31,23 +49,83 @@ public:
 	/// Returns the ID of the current language.
 	///
 	/// \return The ID of the current language.
-	std::string_view current_language_id() const { return m_current_language_id; }
+	std::string_view current_language_id() const { return m_current_language.load(std::memory_order_relaxed)->id; }
 	/// Sets the language of the application to the one with the given ID.
 	///
 	/// \param id The ID of the language to use.
 	void set_language(std::string_view id);
 
+	/// Returns the key of the string with the given name.
+	/// \note The name must be known at compile time and the compilation will
+	/// fail if there is no string with that name.
+	///
+	/// \param name The name of the key (e.g. `"UI.Solutions"`).
+	///
+	/// \return The key of the string.
+	static consteval StringKey string_key(std::string_view name) {
+		for (std::size_t i = 0; i < STRING_KEY_COUNT; ++i) {
+			if (string_key_names[i] == name)
+				return static_cast<StringKey>(i);
+		}
+
+		throw "Invalid key provided!";
+	}
+	/// Returns the key of the name of a card.
+	///
+	/// \param card The card.
+	///
+	/// \return The key of the name of the card.
+	static constexpr StringKey string_key(Card card) {
+		constexpr std::array card_string_keys {
+#define _ENUMERATE_CARD(x) string_key("Card." #x),
+			_ENUMERATE_CARDS
+#undef _ENUMERATE_CARD
+		};
+
+		return card_string_keys[static_cast<std::size_t>(card)];
+	}
+	/// Returns the key of the name of a card category.
+	///
+	/// \param category The card category.
+	///
+	/// \return The key of the name of the card category.
+	static constexpr StringKey string_key(CardCategory category) {
+		switch (category) {
+		case CardCategory::Suspect:
+			return string_key("CardCategory.Suspect");
+		case CardCategory::Weapon:
+			return string_key("CardCategory.Weapon");
+		case CardCategory::Room:
+			return string_key("CardCategory.Room");
+		}
+
+		std::unreachable();
+	}
+	/// Returns the key of the message of an error.
+	///
+	/// \param error The error.
+	///
+	/// \return The key of the message of the error.
+	static constexpr StringKey string_key(Error error) {
+		constexpr std::array error_string_keys {
+#define _ENUMERATE_ERROR(x) string_key("Error." #x),
+			_ENUMERATE_ERRORS
+#undef _ENUMERATE_ERROR
+		};
+
+		return error_string_keys[static_cast<std::size_t>(error)];
+	}
+
 	/// Returns the string with the given key.
-	/// \note The function will fail if the key is not found.
+	/// \note The string is null-terminated.
 	///
 	/// \param key The key of the string.
-	std::string_view get_string(std::string_view key) const;
+	std::string_view get_string(StringKey key) const { return (*m_current_language.load(std::memory_order_relaxed)->strings)[std::to_underlying(key)]; }
 
 private:
-	static std::unique_ptr<LanguageStrings> s_instance;
-	static std::vector<Language> s_languages;
+	static std::vector<Language> const s_languages;
 
-	LanguageStrings() = default;
+	LanguageStrings();
 
 	LanguageStrings(LanguageStrings const&) = delete;
 	LanguageStrings& operator=(LanguageStrings const&) = delete;
@@ -55,23 +133,24 @@ private:
 	LanguageStrings(LanguageStrings&&) = delete;
 	LanguageStrings& operator=(LanguageStrings&&) = delete;
 
-	std::string_view m_current_language_id;
-	nlohmann::json m_strings;
+	std::atomic<Language const*> m_current_language;
 };
 
 /// \def LS(key)
 /// \brief A macro that is used to get a string from the \ref Cluedo::LanguageStrings.
 ///
-/// \param key The key of the string.
-#define LS(key) (Cluedo::LanguageStrings::the().get_string((key)))
+/// \param key The name of the key of the string, which must be known at
+/// compile time, or a \ref Cluedo::Card, \ref Cluedo::CardCategory or \ref Cluedo::Error.
+#define LS(key) (Cluedo::LanguageStrings::the().get_string(Cluedo::LanguageStrings::string_key((key))))
 /// \def CSTR(s)
 /// \brief A macro that is used to get a `char*` from a string.
 ///
 /// The main reason why this macro exists is that the
 /// <a href="https://github.com/ocornut/imgui/">Dear ImGui</a> library doesn't
 /// support `std::string` directly.
+/// \note The string must be null-terminated, like the ones returned by \ref LS.
 ///
 /// \param s The string to convert.
-#define CSTR(s) (std::string { (s) }.c_str())
+#define CSTR(s) ((s).data())
 
 };
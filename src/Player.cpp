@@ -1,5 +1,7 @@
 #include "Player.hpp"
 
+#include <utility>
+
 namespace Cluedo {
 
 void Player::remove_superfluous_possibilities() {
@@ -17,7 +19,7 @@ void Player::remove_superfluous_possibilities() {
 			m_possibilities.erase(m_possibilities.begin() + static_cast<ssize_t>(i - 1));
 }
 
-void Player::simplify_possibilities_with_card(Card card, bool has_card) {
+void Player::simplify_possibilities_with_card(Card card, bool has_card, DeductionCounts& deduction_counts) {
 	remove_superfluous_possibilities();
 
 	for (std::size_t i = m_possibilities.size(); i > 0; --i) {
@@ -31,6 +33,9 @@ void Player::simplify_possibilities_with_card(Card card, bool has_card) {
 			possibility.erase(card);
 			if (possibility.size() == 1) {
 				auto resolved_card = *possibility.begin();
+				if (!m_cards_in_hand.contains(resolved_card))
+					++deduction_counts[std::to_underlying(DeductionRule::SinglePossibility)];
+
 				m_cards_in_hand.insert(resolved_card);
 				should_erase_possibility = true;
 			}
@@ -41,14 +46,16 @@ void Player::simplify_possibilities_with_card(Card card, bool has_card) {
 	}
 }
 
-void Player::check_if_all_cards_in_hand() {
+void Player::check_if_all_cards_in_hand(DeductionCounts& deduction_counts) {
 	if (m_card_count != m_cards_in_hand.size()) {
 		return;
 	}
 
 	for (auto const& card : CardUtils::cards()) {
-		if (!has_card(card))
-			add_not_in_hand_card(card);
+		if (!has_card(card)) {
+			++deduction_counts[std::to_underlying(DeductionRule::FullHand)];
+			add_not_in_hand_card(card, deduction_counts);
+		}
 	}
 }
 
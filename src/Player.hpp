@@ -2,6 +2,7 @@
 
 #include "Card.hpp"
 #include "CardSet.hpp"
+#include "DeductionRule.hpp"
 
 #include <optional>
 #include <string>
@@ -43,6 +44,10 @@ public:
 	///
 	/// \return The number of cards held by the player.
 	std::size_t card_count() const { return m_card_count; }
+	/// Returns an estimate of the memory used by the player.
+	///
+	/// \return The number of bytes used by the player, including the ones of the object itself.
+	std::size_t memory_usage() const { return sizeof(Player) + m_name.capacity() + m_possibilities.capacity() * sizeof(CardSet); }
 
 	/// Checks if a player has a card.
 	///
@@ -60,34 +65,37 @@ public:
 	/// Learns that the player has a card.
 	///
 	/// \param card The card which the player has.
-	void add_in_hand_card(Card card) {
+	/// \param deduction_counts The counts to which the facts inferred are added.
+	void add_in_hand_card(Card card, DeductionCounts& deduction_counts) {
 		m_cards_in_hand.insert(card);
-		simplify_possibilities_with_card(card, true);
-		check_if_all_cards_in_hand();
+		simplify_possibilities_with_card(card, true, deduction_counts);
+		check_if_all_cards_in_hand(deduction_counts);
 	}
 
 	/// Learns that the player doesn't have a card.
 	///
 	/// \param card The card which the player doesn't have.
-	void add_not_in_hand_card(Card card) {
+	/// \param deduction_counts The counts to which the facts inferred are added.
+	void add_not_in_hand_card(Card card, DeductionCounts& deduction_counts) {
 		m_cards_not_in_hand.insert(card);
-		simplify_possibilities_with_card(card, false);
-		check_if_all_cards_in_hand();
+		simplify_possibilities_with_card(card, false, deduction_counts);
+		check_if_all_cards_in_hand(deduction_counts);
 	}
 
 	/// Learns that the player has one of the card specified in \a set.
 	///
 	/// \param set The set of cards of which the player will have one.
-	void add_possible_cards(CardSet const& set) {
+	/// \param deduction_counts The counts to which the facts inferred are added.
+	void add_possible_cards(CardSet const& set, DeductionCounts& deduction_counts) {
 		m_possibilities.push_back(set);
 		remove_superfluous_possibilities();
-		check_if_all_cards_in_hand();
+		check_if_all_cards_in_hand(deduction_counts);
 	}
 
 private:
-	void simplify_possibilities_with_card(Card, bool has_card);
+	void simplify_possibilities_with_card(Card, bool has_card, DeductionCounts& deduction_counts);
 	void remove_superfluous_possibilities();
-	void check_if_all_cards_in_hand();
+	void check_if_all_cards_in_hand(DeductionCounts& deduction_counts);
 
 	std::string m_name;
 	std::size_t m_card_count;
@@ -0,0 +1,190 @@
+#include "Simulator.hpp"
+
+#include <cassert>
+#include <fmt/core.h>
+#include <utility>
+
+namespace Cluedo {
+
+// Counts an event and, if it's running, adds the time from its construction to its destruction to the time of the events.
+class Stopwatch {
+public:
+	Stopwatch(std::size_t& count, std::chrono::nanoseconds& time, bool is_running)
+	  : m_time(time) {
+		++count;
+		if (is_running)
+			m_start_time = std::chrono::steady_clock::now();
+	}
+
+	~Stopwatch() {
+		if (m_start_time)
+			m_time += std::chrono::steady_clock::now() - *m_start_time;
+	}
+
+private:
+	std::chrono::nanoseconds& m_time;
+	std::optional<std::chrono::steady_clock::time_point> m_start_time;
+};
+
+static Deal deal_cards(std::size_t player_count, GameRandom& random) {
+	Deal deal;
+	for (std::size_t i = 0; i < CardUtils::card_categories.size(); ++i) {
+		auto category = CardUtils::card_categories[i];
+		auto card_index = random(CardUtils::cards_per_category(category).count());
+		deal.solution[i] = static_cast<Card>(static_cast<std::uint8_t>(category) + card_index);
+	}
+
+	std::vector<Card> cards;
+	for (auto card : CardUtils::cards()) {
+		if (card != deal.solution[0] && card != deal.solution[1] && card != deal.solution[2])
+			cards.push_back(card);
+	}
+
+	// The cards are shuffled by hand, since std::shuffle isn't the same on every standard library.
+	for (std::size_t i = 0; i + 1 < cards.size(); ++i)
+		std::swap(cards[i], cards[i + random(static_cast<std::uint32_t>(cards.size() - i))]);
+
+	deal.hands.resize(player_count);
+	for (std::size_t i = 0; i < cards.size(); ++i)
+		deal.hands[i % player_count].insert(cards[i]);
+
+	return deal;
+}
+
+static std::vector<PlayerData> players_data(Deal const& deal) {
+	std::vector<PlayerData> players;
+	for (std::size_t i = 0; i < deal.hands.size(); ++i)
+		players.push_back({ fmt::format("Player {}", i + 1), deal.hands[i].size() });
+
+	return players;
+}
+
+static std::vector<Solver::Information> hand_informations(std::size_t player_index, CardSet const& hand) {
+	std::vector<Solver::Information> informations;
+	for (auto card : hand)
+		informations.push_back(Solver::PlayerCardState { player_index, card, true });
+
+	return informations;
+}
+
+// Only the player who made the suggestion and the one who responded see the response card.
+static Solver::Suggestion suggestion_seen_by(Solver::Suggestion suggestion, std::size_t player_index) {
+	if (player_index != suggestion.suggesting_player_index && player_index != suggestion.responding_player_index)
+		suggestion.response_card.reset();
+
+	return suggestion;
+}
+
+static bool agrees_with_deal(Solver const& solver, Deal const& deal) {
+	CardSet solution { deal.solution[0], deal.solution[1], deal.solution[2] };
+	for (std::size_t player_index = 0; player_index <= deal.hands.size(); ++player_index) {
+		auto const& hand = player_index < deal.hands.size() ? deal.hands[player_index] : solution;
+		for (auto card : CardUtils::cards()) {
+			auto has_card = solver.player(player_index).has_card(card);
+			if (has_card && *has_card != hand.contains(card))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+GameRecord SimulatedGame::record_for_player(std::size_t player_index) const {
+	GameRecord record { players_data(deal), hand_informations(player_index, deal.hands[player_index]) };
+	for (auto const& suggestion : suggestions)
+		record.informations.push_back(suggestion_seen_by(suggestion, player_index));
+
+	return record;
+}
+
+SimulatedGame simulate_game(std::span<Strategy* const> strategies, SimulationOptions const& options, std::uint64_t seed, std::uint64_t game_index) {
+	auto player_count = strategies.size();
+
+	// Each game has its own stream of the generator, so that it doesn't depend on the other games.
+	GameRandom random(seed, game_index);
+
+	SimulatedGame game;
+	game.deal = deal_cards(player_count, random);
+	game.player_timings.resize(player_count);
+
+	auto decide = [&game, &options](std::size_t player_index, auto&& decision) {
+		auto& timings = game.player_timings[player_index];
+		Stopwatch stopwatch(timings.decision_count, timings.decision_time, options.measure_time);
+		return decision();
+	};
+
+	auto players = players_data(game.deal);
+	std::vector<Solver> solvers;
+	for (std::size_t i = 0; i < player_count; ++i) {
+		auto maybe_solver = Solver::create(players);
+		assert(maybe_solver.is_value());
+
+		auto& solver = solvers.emplace_back(maybe_solver.release_value());
+		auto& timings = game.player_timings[i];
+		for (auto const& information : hand_informations(i, game.deal.hands[i])) {
+			Stopwatch stopwatch(timings.update_count, timings.update_time, options.measure_time);
+			solver.learn(information);
+		}
+
+		strategies[i]->begin_game(i, game.deal.hands[i]);
+	}
+
+	std::vector<bool> is_eliminated(player_count, false);
+	for (std::size_t turn = 0; game.eliminated_player_indices.size() < player_count; ++turn) {
+		auto player_index = turn % player_count;
+		if (is_eliminated[player_index])
+			continue;
+
+		auto& strategy = *strategies[player_index];
+		auto const& solver = solvers[player_index];
+		auto accusation = decide(player_index, [&]() { return strategy.choose_accusation(solver, random); });
+		if (accusation) {
+			if (*accusation == game.deal.solution) {
+				game.winner_index = player_index;
+				break;
+			}
+
+			is_eliminated[player_index] = true;
+			game.eliminated_player_indices.push_back(player_index);
+			continue;
+		}
+
+		if (game.suggestions.size() == options.max_suggestion_count)
+			break;
+
+		auto [suspect, weapon, room] = decide(player_index, [&]() { return strategy.choose_suggestion(solver, random); });
+		Solver::Suggestion suggestion { player_index, suspect, weapon, room, std::nullopt, std::nullopt };
+
+		CardSet suggested_cards { suspect, weapon, room };
+		for (std::size_t offset = 1; offset < player_count; ++offset) {
+			auto responding_player_index = (player_index + offset) % player_count;
+			auto cards = CardSet::intersection(game.deal.hands[responding_player_index], suggested_cards);
+			if (cards.empty())
+				continue;
+
+			auto& responding_strategy = *strategies[responding_player_index];
+			suggestion.responding_player_index = responding_player_index;
+			suggestion.response_card = decide(responding_player_index, [&]() { return responding_strategy.choose_response_card(cards, player_index, random); });
+			break;
+		}
+
+		for (std::size_t i = 0; i < player_count; ++i) {
+			auto& timings = game.player_timings[i];
+			{
+				Stopwatch stopwatch(timings.update_count, timings.update_time, options.measure_time);
+				solvers[i].learn(suggestion_seen_by(suggestion, i));
+			}
+
+			game.is_consistent &= solvers[i].are_constraints_satisfied();
+		}
+
+		game.suggestions.push_back(suggestion);
+	}
+
+	for (auto const& solver : solvers)
+		game.is_consistent &= agrees_with_deal(solver, game.deal);
+
+	return game;
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CardSet.hpp"
+#include "GameRecord.hpp"
+#include "Solver.hpp"
+#include "Strategy.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+/// \file Simulator.hpp
+/// \brief The file that contains the definitions of the functions that simulate games between strategies.
+
+namespace Cluedo {
+
+/// \brief A struct that contains the options of a simulated game.
+struct SimulationOptions {
+	std::size_t max_suggestion_count { 200 }; ///< The number of suggestions after which the game is abandoned.
+	bool measure_time { false };              ///< `true` if the time spent by the players is measured, see \ref Cluedo::PlayerTimings.
+};
+
+/// \brief A struct that contains the cards dealt in a game.
+struct Deal {
+	SolutionCards solution;     ///< The suspect, the weapon and the room of the solution.
+	std::vector<CardSet> hands; ///< The cards held by each player.
+};
+
+/// \brief A struct that contains the time that a player spent in their strategy and in their solver during a game.
+/// \note The times are only measured if \ref Cluedo::SimulationOptions::measure_time
+/// is set, since reading the clock for every event makes the games noticeably slower.
+struct PlayerTimings {
+	std::size_t decision_count { 0 };             ///< The number of decisions made by the strategy.
+	std::chrono::nanoseconds decision_time { 0 }; ///< The time spent making them.
+	std::size_t update_count { 0 };               ///< The number of pieces of information learnt by the solver.
+	std::chrono::nanoseconds update_time { 0 };   ///< The time spent learning them.
+};
+
+/// \brief The result of a simulated game.
+///
+/// The game is played in turns: on their turn a player either accuses or
+/// makes a suggestion, to which the other players respond in order. A player
+/// wins with the right accusation and is out of the game with a wrong one,
+/// but they still respond to the suggestions of the others.
+///
+/// Each player feeds what they see to their own \ref Cluedo::Solver, on which
+/// their \ref Cluedo::Strategy bases its decisions, so the response card is
+/// only known to the player who made the suggestion and to the one who responded.
+struct SimulatedGame {
+	Deal deal;                                          ///< The cards dealt, which are the ground truth of the game.
+	std::vector<Solver::Suggestion> suggestions;        ///< The suggestions made, with the response card whenever someone responded.
+	std::optional<std::size_t> winner_index;            ///< The index of the player who won, if anyone did.
+	std::vector<std::size_t> eliminated_player_indices; ///< The indices of the players who made a wrong accusation, in order.
+	std::vector<PlayerTimings> player_timings;          ///< The time spent by each player.
+	bool is_consistent { true };                        ///< `false` if a solver contradicted the deal.
+
+	/// Returns the record of the game as seen by a player: their cards and
+	/// the suggestions, with the response cards they saw.
+	///
+	/// \param player_index The index of the player.
+	///
+	/// \return The record of the game.
+	GameRecord record_for_player(std::size_t player_index) const;
+};
+
+/// Simulates a game.
+/// \note The game only depends on the strategies, the options, the seed and
+/// its index, so games can be simulated in any order and on any thread and
+/// still be the same.
+///
+/// \param strategies The strategy of each player, in the order they play,
+/// which must be between \ref Cluedo::Solver::MIN_PLAYER_COUNT and
+/// \ref Cluedo::Solver::MAX_PLAYER_COUNT.
+/// \param options The options of the game.
+/// \param seed The seed of the series of games.
+/// \param game_index The index of the game in the series.
+///
+/// \return The result of the game.
+SimulatedGame simulate_game(std::span<Strategy* const> strategies, SimulationOptions const& options, std::uint64_t seed, std::uint64_t game_index);
+
+}
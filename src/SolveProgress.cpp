@@ -0,0 +1,101 @@
+#include "SolveProgress.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Cluedo {
+
+void SolveProgress::reset(std::size_t player_count) {
+	for (auto& valid_sample_count : m_valid_sample_counts)
+		valid_sample_count.store(0, std::memory_order_relaxed);
+
+	for (auto& owner_counts : m_card_owner_counts) {
+		for (auto& count : owner_counts)
+			count.store(0, std::memory_order_relaxed);
+	}
+
+	m_owner_count.store(player_count + 1, std::memory_order_relaxed);
+
+	m_sample_count.store(0, std::memory_order_release);
+}
+
+std::size_t SolveProgress::valid_sample_count() const {
+	return std::accumulate(m_valid_sample_counts.begin(), m_valid_sample_counts.end(), std::size_t { 0 }, [](std::size_t accumulator, auto const& valid_sample_count) { return accumulator + valid_sample_count.load(std::memory_order_relaxed); });
+}
+
+std::vector<Solver::SolutionProbabilityPair> SolveProgress::solutions() const {
+	std::vector<Solver::SolutionProbabilityPair> solution_probabilities;
+
+	for (auto suspect : CardUtils::cards_per_category(CardCategory::Suspect)) {
+		for (auto weapon : CardUtils::cards_per_category(CardCategory::Weapon)) {
+			for (auto room : CardUtils::cards_per_category(CardCategory::Room)) {
+				auto valid_sample_count = m_valid_sample_counts.at(solution_index(suspect, weapon, room)).load(std::memory_order_relaxed);
+				if (valid_sample_count > 0)
+					solution_probabilities.emplace_back(std::make_tuple(suspect, weapon, room), valid_sample_count);
+			}
+		}
+	}
+
+	auto total_valid_sample_count = std::accumulate(solution_probabilities.begin(), solution_probabilities.end(), 0.0f, [](auto const& accumulator, auto const& pair) { return accumulator + pair.second; });
+
+	for (auto& pair : solution_probabilities)
+		pair.second /= total_valid_sample_count;
+
+	std::sort(solution_probabilities.begin(), solution_probabilities.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+
+	return solution_probabilities;
+}
+
+Solver::CardOwnershipProbabilities SolveProgress::card_ownership_probabilities() const {
+	auto owner_count = m_owner_count.load(std::memory_order_relaxed);
+	Solver::CardOwnershipProbabilities probabilities(owner_count);
+
+	CardOwnerCounts card_owner_counts;
+	for (std::size_t owner_index = 0; owner_index < owner_count; ++owner_index) {
+		for (std::size_t card_index = 0; card_index < CardUtils::CARD_COUNT; ++card_index)
+			card_owner_counts[owner_index][card_index] = m_card_owner_counts[owner_index][card_index].load(std::memory_order_relaxed);
+	}
+
+	// The valid samples are loaded after the owners and after a fence that pairs with the one in add_samples,
+	// so that they include every sample whose owners were loaded and no probability is above one.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	auto total_valid_sample_count = valid_sample_count();
+	if (total_valid_sample_count == 0)
+		return probabilities;
+
+	for (std::size_t owner_index = 0; owner_index < owner_count; ++owner_index) {
+		for (std::size_t card_index = 0; card_index < CardUtils::CARD_COUNT; ++card_index)
+			probabilities[owner_index][card_index] = static_cast<float>(card_owner_counts[owner_index][card_index]) / static_cast<float>(total_valid_sample_count);
+	}
+
+	return probabilities;
+}
+
+std::size_t SolveProgress::solution_index(Card suspect, Card weapon, Card room) {
+	auto suspect_index = static_cast<std::size_t>(suspect) - static_cast<std::size_t>(CardCategory::Suspect);
+	auto weapon_index = static_cast<std::size_t>(weapon) - static_cast<std::size_t>(CardCategory::Weapon);
+	auto room_index = static_cast<std::size_t>(room) - static_cast<std::size_t>(CardCategory::Room);
+	return (suspect_index * 6 + weapon_index) * 9 + room_index;
+}
+
+void SolveProgress::add_samples(std::size_t solution_index, std::size_t valid_sample_count, std::size_t sample_count, CardOwnerCounts const& card_owner_counts) {
+	m_valid_sample_counts.at(solution_index).fetch_add(valid_sample_count, std::memory_order_relaxed);
+
+	// The owners are added after the valid samples and after a fence that pairs with the one in
+	// card_ownership_probabilities, so that a reader that sees the owners of a sample also sees the sample.
+	if (valid_sample_count > 0) {
+		std::atomic_thread_fence(std::memory_order_release);
+
+		auto owner_count = m_owner_count.load(std::memory_order_relaxed);
+		for (std::size_t owner_index = 0; owner_index < owner_count; ++owner_index) {
+			for (std::size_t card_index = 0; card_index < CardUtils::CARD_COUNT; ++card_index) {
+				if (card_owner_counts[owner_index][card_index] > 0)
+					m_card_owner_counts[owner_index][card_index].fetch_add(card_owner_counts[owner_index][card_index], std::memory_order_relaxed);
+			}
+		}
+	}
+
+	m_sample_count.fetch_add(sample_count, std::memory_order_release);
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Solver.hpp"
+
+#include <array>
+#include <atomic>
+
+/// \file SolveProgress.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::SolveProgress class.
+
+namespace Cluedo {
+
+/// \brief The progress of a search for the most likely solutions.
+///
+/// While searching, \ref Cluedo::Solver::find_most_likely_solutions samples
+/// every solution a few times in turn and adds the results to this object, so
+/// that the estimates can be read from another thread while the search is
+/// still refining them. The counters are atomic, so neither the search nor
+/// the readers ever have to wait for each other.
+///
+/// Besides the solutions, it counts who holds each card in the valid samples,
+/// which gives the probability of each player holding each card without a
+/// separate search.
+class SolveProgress {
+public:
+	static constexpr std::size_t SOLUTION_COUNT = 6 * 6 * 9;                  ///< The number of combinations of a suspect, a weapon and a room.
+	static constexpr std::size_t MAX_OWNER_COUNT = Solver::MAX_PLAYER_COUNT + 1; ///< The maximum number of owners of the cards, the players and the solution.
+
+	/// Clears the progress, so that it can be used for a new search.
+	/// \note This method must not be called while a search is using this object.
+	///
+	/// \param player_count The number of players of the game that will be searched.
+	void reset(std::size_t player_count);
+
+	/// Returns the number of samples taken so far.
+	///
+	/// \return The number of samples taken so far.
+	std::size_t sample_count() const { return m_sample_count.load(std::memory_order_acquire); }
+	/// Returns the number of samples taken so far that were consistent with what is known.
+	///
+	/// \return The number of valid samples taken so far.
+	std::size_t valid_sample_count() const;
+
+	/// Returns the current estimate of the solutions.
+	/// \note The solutions for which no valid sample was found yet are left out.
+	///
+	/// \return The list of solutions ordered by their probability.
+	std::vector<Solver::SolutionProbabilityPair> solutions() const;
+
+	/// Returns the current estimate of the probabilities of each player holding each card.
+	///
+	/// \return The probabilities, which are all zero if no valid sample was found yet.
+	Solver::CardOwnershipProbabilities card_ownership_probabilities() const;
+
+private:
+	friend Solver;
+
+	using CardOwnerCounts = std::array<std::array<std::size_t, CardUtils::CARD_COUNT>, MAX_OWNER_COUNT>;
+
+	static std::size_t solution_index(Card suspect, Card weapon, Card room);
+
+	void add_samples(std::size_t solution_index, std::size_t valid_sample_count, std::size_t sample_count, CardOwnerCounts const& card_owner_counts);
+
+	std::array<std::atomic<std::size_t>, SOLUTION_COUNT> m_valid_sample_counts {};
+	std::array<std::array<std::atomic<std::size_t>, CardUtils::CARD_COUNT>, MAX_OWNER_COUNT> m_card_owner_counts {};
+	std::atomic<std::size_t> m_owner_count { 0 };
+	std::atomic<std::size_t> m_sample_count { 0 };
+};
+
+}
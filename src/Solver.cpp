@@ -1,15 +1,17 @@
 #include "Solver.hpp"
+#include "SolveProgress.hpp"
+#include "utils/BinaryStream.hpp"
 
 #include <algorithm>
 #include <fmt/core.h>
 #include <fmt/ranges.h>
+#include <limits>
 #include <numeric>
 #include <pcg_random.hpp>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
-
-#include "LanguageStrings.hpp"
+#include <utility>
 
 namespace Cluedo {
 
@@ -17,13 +19,17 @@ Result<Solver, Error> Solver::create(std::vector<PlayerData> const& players_data
 	if (players_data.size() < MIN_PLAYER_COUNT || players_data.size() > MAX_PLAYER_COUNT)
 		return Error::InvalidNumberOfPlayers;
 
+	// A player can't hold more cards than there are, which also keeps the sum from wrapping around.
+	if (std::any_of(players_data.begin(), players_data.end(), [](PlayerData const& player_data) { return player_data.card_count > CardUtils::CARD_COUNT; }))
+		return Error::InvalidNumberOfCards;
+
 	std::size_t total_cards = std::accumulate(players_data.begin(), players_data.end(), SOLUTION_CARD_COUNT, [](std::size_t const& accumulator, PlayerData const& player_data) { return accumulator + player_data.card_count; });
 	if (total_cards != CardUtils::CARD_COUNT)
 		return Error::InvalidNumberOfCards;
 
 	std::vector<Player> players;
 	for (std::size_t i = 0; i < players_data.size(); ++i) {
-		auto name = !players_data.at(i).name.empty() ? players_data.at(i).name : fmt::format("{} {}", Cluedo::LanguageStrings::the().get_string("Solver.Player"), i + 1);
+		auto name = !players_data.at(i).name.empty() ? players_data.at(i).name : fmt::format("Player {}", i + 1);
 		players.emplace_back(name, players_data.at(i).card_count);
 	}
 	players.emplace_back("", SOLUTION_CARD_COUNT);
@@ -32,15 +38,24 @@ Result<Solver, Error> Solver::create(std::vector<PlayerData> const& players_data
 }
 
 void Solver::learn_player_card_state(std::size_t player_index, Card card, bool has_card, bool infer_new_info) {
+	save_player_for_undo(player_index);
+
 	if (has_card)
-		player(player_index).add_in_hand_card(card);
+		player(player_index).add_in_hand_card(card, m_deduction_counts);
 	else
-		player(player_index).add_not_in_hand_card(card);
+		player(player_index).add_not_in_hand_card(card, m_deduction_counts);
+
+	check_player_for_contradictions(player_index);
+	if (m_has_contradiction)
+		return;
 
 	if (player_index == solution_player_index() && has_card) {
 		for (auto other_card : CardUtils::cards_per_category(CardUtils::card_category(card))) {
 			if (other_card != card)
 				learn_player_card_state(player_index, other_card, false, false);
+
+			if (m_has_contradiction)
+				return;
 		}
 	}
 
@@ -60,17 +75,41 @@ void Solver::learn_player_has_any_of_cards(std::size_t player_index, CardSet con
 		new_card_set.insert(card);
 	}
 
-	std::vector<Card> cards;
-	for (auto card : new_card_set) {
-		cards.push_back(card);
+	// The player can't have any of the cards, so the information is wrong.
+	if (new_card_set.empty()) {
+		m_has_contradiction = true;
+		return;
+	}
+
+	if (new_card_set.size() == 1) {
+		learn_player_card_state(player_index, *new_card_set.begin(), true, infer_new_info);
+		return;
 	}
 
-	player(player_index).add_possible_cards(new_card_set);
+	save_player_for_undo(player_index);
+	player(player_index).add_possible_cards(new_card_set, m_deduction_counts);
+
+	check_player_for_contradictions(player_index);
+	if (m_has_contradiction)
+		return;
 
 	if (infer_new_info)
 		infer_new_information();
 }
 
+bool Solver::is_valid_suggestion(Suggestion const& suggestion, std::size_t player_count) {
+	if (suggestion.suggesting_player_index >= player_count)
+		return false;
+
+	if (suggestion.responding_player_index && (*suggestion.responding_player_index >= player_count || *suggestion.responding_player_index == suggestion.suggesting_player_index))
+		return false;
+
+	if (CardUtils::card_category(suggestion.suspect) != CardCategory::Suspect || CardUtils::card_category(suggestion.weapon) != CardCategory::Weapon || CardUtils::card_category(suggestion.room) != CardCategory::Room)
+		return false;
+
+	return !suggestion.response_card || *suggestion.response_card == suggestion.suspect || *suggestion.response_card == suggestion.weapon || *suggestion.response_card == suggestion.room;
+}
+
 void Solver::learn_from_suggestion(Suggestion const& suggestion, bool infer_new_info) {
 	auto increment_cycling_index = [&](std::size_t index) { return (index + 1) % (m_players.size() - 1); };
 
@@ -89,13 +128,40 @@ void Solver::learn_from_suggestion(Suggestion const& suggestion, bool infer_new_
 		learn_player_card_state(player_index, suggestion.suspect, false, false);
 		learn_player_card_state(player_index, suggestion.weapon, false, false);
 		learn_player_card_state(player_index, suggestion.room, false, false);
+
+		if (m_has_contradiction)
+			return;
 	}
 
-	if (infer_new_info)
+	if (infer_new_info && !m_has_contradiction)
 		infer_new_information();
 }
 
+void Solver::learn(Information const& information, bool infer_new_info) {
+	if (auto const* player_card_state = std::get_if<PlayerCardState>(&information))
+		learn_player_card_state(player_card_state->player_index, player_card_state->card, player_card_state->has_card, infer_new_info);
+	else
+		learn_from_suggestion(std::get<Suggestion>(information), infer_new_info);
+}
+
+std::size_t Solver::learn_in_transactions(std::span<Information const> informations) {
+	m_trail.reserve(m_trail.size() + informations.size());
+	m_undo_marks.reserve(m_undo_marks.size() + informations.size());
+
+	for (std::size_t i = 0; i < informations.size(); ++i) {
+		begin_transaction();
+		learn(informations[i]);
+		if (!commit_transaction())
+			return i;
+	}
+
+	return informations.size();
+}
+
 bool Solver::are_constraints_satisfied() const {
+	if (m_has_contradiction)
+		return false;
+
 	for (auto const& player : m_players) {
 		if (!CardSet::intersection(player.m_cards_in_hand, player.m_cards_not_in_hand).empty())
 			return false;
@@ -104,6 +170,247 @@ bool Solver::are_constraints_satisfied() const {
 	return true;
 }
 
+void Solver::begin_transaction() {
+	assert(!m_in_transaction);
+
+	m_undo_marks.push_back({ m_trail.size(), m_next_undo_mark_serial++, m_has_contradiction });
+	m_in_transaction = true;
+}
+
+bool Solver::commit_transaction() {
+	assert(m_in_transaction);
+
+	if (!are_constraints_satisfied()) {
+		rollback_transaction();
+		return false;
+	}
+
+	m_in_transaction = false;
+	return true;
+}
+
+void Solver::rollback_transaction() {
+	assert(m_in_transaction);
+
+	m_in_transaction = false;
+	restore_to_undo_mark();
+}
+
+void Solver::clear_undo_steps() {
+	assert(!m_in_transaction);
+
+	m_trail.clear();
+	m_undo_marks.clear();
+}
+
+Solver Solver::snapshot() const {
+	assert(!m_in_transaction);
+
+	Solver solver { std::vector<Player>(m_players) };
+	solver.m_has_contradiction = m_has_contradiction;
+	return solver;
+}
+
+std::size_t Solver::memory_usage() const {
+	auto usage = sizeof(Solver);
+	usage += (m_players.capacity() - m_players.size()) * sizeof(Player);
+	for (auto const& player : m_players)
+		usage += player.memory_usage();
+
+	usage += m_trail.capacity() * sizeof(TrailEntry);
+	for (auto const& entry : m_trail)
+		usage += entry.possibilities.capacity() * sizeof(CardSet);
+
+	usage += m_undo_marks.capacity() * sizeof(UndoMark);
+	usage += m_player_saved_undo_mark_serials.capacity() * sizeof(std::size_t);
+	return usage;
+}
+
+static constexpr std::string_view BINARY_MAGIC = "CLSV";
+
+Result<std::string, Error> Solver::to_binary() const {
+	assert(!m_in_transaction);
+
+	std::string data;
+	BinaryWriter writer(data);
+	writer.write_bytes(BINARY_MAGIC);
+	writer.write(BINARY_VERSION);
+	writer.write(static_cast<std::uint8_t>(player_count()));
+	writer.write(static_cast<std::uint8_t>(m_has_contradiction));
+	for (std::size_t i = 0; i < player_count(); ++i) {
+		auto const& name = m_players[i].m_name;
+		if (name.size() > std::numeric_limits<std::uint8_t>::max() || m_players[i].m_card_count > std::numeric_limits<std::uint8_t>::max())
+			return Error::InvalidSolverState;
+
+		writer.write(static_cast<std::uint8_t>(m_players[i].m_card_count));
+		writer.write(static_cast<std::uint8_t>(name.size()));
+		writer.write_bytes(name);
+	}
+
+	for (auto const& player : m_players) {
+		if (player.m_possibilities.size() > std::numeric_limits<std::uint16_t>::max())
+			return Error::InvalidSolverState;
+
+		writer.write(player.m_cards_in_hand.mask());
+		writer.write(player.m_cards_not_in_hand.mask());
+		writer.write(static_cast<std::uint16_t>(player.m_possibilities.size()));
+		for (auto const& possibility : player.m_possibilities)
+			writer.write(possibility.mask());
+	}
+
+	return data;
+}
+
+Result<Solver, Error> Solver::from_binary(std::string_view data) {
+	if (!data.starts_with(BINARY_MAGIC))
+		return Error::InvalidSolverState;
+
+	BinaryReader reader(data.substr(BINARY_MAGIC.size()));
+	auto version = reader.read<std::uint8_t>();
+	auto player_count = reader.read<std::uint8_t>();
+	auto has_contradiction = reader.read<std::uint8_t>();
+	if (version != BINARY_VERSION || !player_count || !has_contradiction || *has_contradiction > 1)
+		return Error::InvalidSolverState;
+
+	std::vector<PlayerData> players_data;
+	for (std::size_t i = 0; i < *player_count; ++i) {
+		auto card_count = reader.read<std::uint8_t>();
+		auto name_size = reader.read<std::uint8_t>();
+		auto name = name_size ? reader.read_bytes(*name_size) : std::nullopt;
+		if (!card_count || !name)
+			return Error::InvalidSolverState;
+
+		players_data.push_back({ std::string(*name), *card_count });
+	}
+
+	auto maybe_solver = create(players_data);
+	if (maybe_solver.is_error())
+		return Error::InvalidSolverState;
+
+	auto solver = maybe_solver.release_value();
+
+	auto read_card_set = [&reader]() -> std::optional<CardSet> {
+		auto mask = reader.read<std::uint32_t>();
+		if (!mask || *mask >> CardUtils::CARD_COUNT != 0)
+			return std::nullopt;
+
+		return CardSet::from_mask(*mask);
+	};
+
+	CardSet owned_cards;
+	for (auto& player : solver.m_players) {
+		auto cards_in_hand = read_card_set();
+		auto cards_not_in_hand = read_card_set();
+		auto possibility_count = reader.read<std::uint16_t>();
+		if (!cards_in_hand || !cards_not_in_hand || !possibility_count || !CardSet::intersection(*cards_in_hand, *cards_not_in_hand).empty() || cards_in_hand->size() > player.m_card_count)
+			return Error::InvalidSolverState;
+
+		// A card can't be held by two owners.
+		if (!CardSet::intersection(owned_cards, *cards_in_hand).empty())
+			return Error::InvalidSolverState;
+
+		owned_cards.set_union(*cards_in_hand);
+
+		player.m_cards_in_hand = *cards_in_hand;
+		player.m_cards_not_in_hand = *cards_not_in_hand;
+		for (std::size_t i = 0; i < *possibility_count; ++i) {
+			auto possibility = read_card_set();
+			if (!possibility || possibility->empty())
+				return Error::InvalidSolverState;
+
+			player.m_possibilities.push_back(*possibility);
+		}
+	}
+
+	if (reader.remaining_size() != 0)
+		return Error::InvalidSolverState;
+
+	// What follows from the state is inferred again rather than trusted, a
+	// contradiction that was stored is kept though, since it may come from an
+	// information that left no trace in the players.
+	for (std::size_t player_index = 0; player_index < solver.m_players.size() && !solver.m_has_contradiction; ++player_index) {
+		solver.check_player_for_contradictions(player_index);
+
+		// A player can't be without all the cards of one of their possibilities.
+		auto const& player = solver.m_players[player_index];
+		for (auto const& possibility : player.m_possibilities) {
+			if (CardSet::intersection(possibility, player.m_cards_in_hand).empty() && possibility.is_subset(player.m_cards_not_in_hand))
+				solver.m_has_contradiction = true;
+		}
+	}
+
+	if (!solver.m_has_contradiction)
+		solver.infer_new_information();
+
+	if (solver.m_has_contradiction && !*has_contradiction)
+		return Error::InvalidSolverState;
+
+	solver.m_has_contradiction = *has_contradiction;
+	solver.m_deduction_counts = {};
+	return solver;
+}
+
+void Solver::undo() {
+	assert(!m_in_transaction);
+
+	restore_to_undo_mark();
+}
+
+void Solver::restore_to_undo_mark() {
+	assert(!m_undo_marks.empty());
+
+	auto mark = m_undo_marks.back();
+	m_undo_marks.pop_back();
+	m_has_contradiction = mark.had_contradiction;
+
+	// The entries are restored from the newest to the oldest, so that each
+	// player ends up with the cards it had when the mark was pushed.
+	while (m_trail.size() > mark.trail_size) {
+		auto& entry = m_trail.back();
+		auto& p = m_players.at(entry.player_index);
+		p.m_cards_in_hand = entry.cards_in_hand;
+		p.m_cards_not_in_hand = entry.cards_not_in_hand;
+		p.m_possibilities = std::move(entry.possibilities);
+		m_trail.pop_back();
+	}
+}
+
+void Solver::save_player_for_undo(std::size_t player_index) {
+	if (!m_in_transaction)
+		return;
+
+	// A player needs to be saved only the first time it changes after the last mark.
+	auto& saved_serial = m_player_saved_undo_mark_serials.at(player_index);
+	if (saved_serial == m_undo_marks.back().serial)
+		return;
+
+	saved_serial = m_undo_marks.back().serial;
+	auto const& p = m_players.at(player_index);
+	m_trail.push_back({ player_index, p.m_cards_in_hand, p.m_cards_not_in_hand, p.m_possibilities });
+}
+
+void Solver::check_player_for_contradictions(std::size_t player_index) {
+	auto const& p = m_players.at(player_index);
+
+	if (!CardSet::intersection(p.m_cards_in_hand, p.m_cards_not_in_hand).empty()
+	    || p.m_cards_in_hand.size() > p.card_count()
+	    || CardUtils::CARD_COUNT - p.m_cards_not_in_hand.size() < p.card_count()
+	    || std::any_of(p.m_possibilities.begin(), p.m_possibilities.end(), [](auto const& possibility) { return possibility.empty(); })) {
+		m_has_contradiction = true;
+		return;
+	}
+
+	for (std::size_t other_player_index = 0; other_player_index < m_players.size(); ++other_player_index) {
+		if (other_player_index == player_index)
+			continue;
+
+		if (!CardSet::intersection(p.m_cards_in_hand, m_players.at(other_player_index).m_cards_in_hand).empty()) {
+			m_has_contradiction = true;
+			return;
+		}
+	}
+}
+
 void Solver::infer_new_information() {
 	// This loops goes over all cards, and checks if all players but one have it.
 	// In that case we know the player who owns it.
@@ -126,16 +433,26 @@ void Solver::infer_new_information() {
 
 			card_owned = true;
 			for (std::size_t other_player_index = 0; other_player_index < m_players.size(); ++other_player_index) {
-				if (!m_players.at(other_player_index).has_card(card))
+				if (!m_players.at(other_player_index).has_card(card)) {
+					++m_deduction_counts[std::to_underlying(DeductionRule::OwnedCard)];
 					learn_player_card_state(other_player_index, card, false, false);
+				}
 			}
 			break;
 		}
 
+		// Nobody can have the card, so the information is wrong.
+		if (!card_owned && player_who_dont_own_card_count == m_players.size())
+			m_has_contradiction = true;
+
 		if (!card_owned && player_who_dont_own_card_count == m_players.size() - 1) {
 			assert(player_index_who_might_have_card < m_players.size());
+			++m_deduction_counts[std::to_underlying(DeductionRule::LastPossibleOwner)];
 			learn_player_card_state(player_index_who_might_have_card, card, true, false);
 		}
+
+		if (m_has_contradiction)
+			return;
 	}
 
 	// Here we try to infer some more specific information on the solution knowing it has one card of each category.
@@ -164,8 +481,13 @@ void Solver::infer_new_information() {
 		}
 
 		// If the solution doesn't have a card of this category and we found the solution card
-		if (!solution_has_category && solution_card)
+		if (!solution_has_category && solution_card) {
+			++m_deduction_counts[std::to_underlying(DeductionRule::SolutionCategory)];
 			learn_player_card_state(solution_player_index(), *solution_card, true, false);
+		}
+
+		if (m_has_contradiction)
+			return;
 	}
 
 	// This loops checks if any players have some possibilities in common.
@@ -182,6 +504,12 @@ void Solver::infer_new_information() {
 	}
 
 	for (auto const& [possibility, players] : possibilities_to_players_map) {
+		// Each player needs a different card of the possibility, so there can't be more players than cards.
+		if (players.size() > possibility.size()) {
+			m_has_contradiction = true;
+			return;
+		}
+
 		if (players.size() < possibility.size())
 			continue;
 
@@ -189,8 +517,15 @@ void Solver::infer_new_information() {
 			if (players.contains(player_index))
 				continue;
 
-			for (auto const& card : possibility)
+			for (auto const& card : possibility) {
+				if (!m_players.at(player_index).has_card(card))
+					++m_deduction_counts[std::to_underlying(DeductionRule::SharedPossibilities)];
+
 				learn_player_card_state(player_index, card, false, false);
+			}
+
+			if (m_has_contradiction)
+				return;
 		}
 	}
 }
@@ -246,43 +581,99 @@ bool Solver::are_constraints_satisfied_for_solution_search() const {
 	return true;
 }
 
-std::vector<Solver::SolutionProbabilityPair> Solver::find_most_likely_solutions() const {
-	std::unordered_map<CardCategory, CardSet> possible_solution_cards;
-	for (auto const& card : player(solution_player_index()).m_cards_in_hand)
-		possible_solution_cards.insert({ CardUtils::card_category(card), { card } });
+// Returns the cards of each category that may be in the solution, in the order of the categories.
+std::array<CardSet, Solver::SOLUTION_CARD_COUNT> Solver::possible_solution_cards() const {
+	auto const& solution_player = player(solution_player_index());
+
+	std::array<CardSet, SOLUTION_CARD_COUNT> cards;
+	for (std::size_t i = 0; i < CardUtils::card_categories.size(); ++i) {
+		for (auto card : CardUtils::cards_per_category(CardUtils::card_categories[i])) {
+			auto has_card = solution_player.has_card(card);
+			// The solution has only one card of each category, so the one it's known to have is the only possible one.
+			if (has_card == true) {
+				cards[i] = { card };
+				break;
+			}
 
-	for (auto card_category : CardUtils::card_categories) {
-		if (possible_solution_cards.contains(card_category))
-			continue;
+			if (!has_card)
+				cards[i].insert(card);
+		}
+	}
 
-		possible_solution_cards.insert({ card_category, {} });
-		for (auto card : CardUtils::cards_per_category(card_category)) {
-			if (player(solution_player_index()).m_cards_not_in_hand.contains(card))
-				continue;
+	return cards;
+}
+
+// Returns a copy of the players that knows the solution, or nothing if the solution contradicts what is known.
+std::optional<Solver> Solver::solver_for_solution(Card suspect, Card weapon, Card room) const {
+	// Only the players are copied, as the samples never need to be undone.
+	Solver solver { std::vector<Player>(m_players) };
+
+	solver.learn_player_card_state(solver.solution_player_index(), suspect, true, false);
+	solver.learn_player_card_state(solver.solution_player_index(), weapon, true, false);
+	solver.learn_player_card_state(solver.solution_player_index(), room, true, false);
+	solver.infer_new_information();
+
+	if (solver.m_has_contradiction)
+		return std::nullopt;
 
-			possible_solution_cards.at(card_category).insert(card);
+	return solver;
+}
+
+std::vector<std::tuple<Card, Card, Card>> Solver::possible_solutions(std::size_t max_solution_count) const {
+	std::vector<std::tuple<Card, Card, Card>> solutions;
+	auto [suspects, weapons, rooms] = possible_solution_cards();
+	for (auto suspect : suspects) {
+		for (auto weapon : weapons) {
+			for (auto room : rooms) {
+				if (solutions.size() == max_solution_count)
+					return solutions;
+
+				if (solver_for_solution(suspect, weapon, room))
+					solutions.emplace_back(suspect, weapon, room);
+			}
 		}
 	}
 
-	auto solution_count = possible_solution_cards.at(CardCategory::Suspect).size() * possible_solution_cards.at(CardCategory::Weapon).size() * possible_solution_cards.at(CardCategory::Room).size();
-	auto max_iterations_per_solution = MAX_ITERATIONS / solution_count;
+	return solutions;
+}
+
+std::vector<Solver::SolutionProbabilityPair> Solver::find_most_likely_solutions(SolveProgress* progress, std::stop_token stop_token, SearchOptions const& options) const {
+	auto [suspects, weapons, rooms] = possible_solution_cards();
+
+	auto solution_count = suspects.size() * weapons.size() * rooms.size();
+	auto max_iterations_per_solution = solution_count > 0 ? options.max_sample_count / solution_count : 0;
 
-	pcg_extras::seed_seq_from<std::random_device> seed_source;
-	pcg64_fast prng(seed_source);
+	pcg64_fast prng;
+	if (options.seed) {
+		prng.seed(*options.seed);
+	} else {
+		pcg_extras::seed_seq_from<std::random_device> seed_source;
+		prng.seed(seed_source);
+	}
 
 	std::vector<SolutionProbabilityPair> solution_probabilities;
 
-	for (auto suspect : CardUtils::cards_per_category(CardCategory::Suspect)) {
-		for (auto weapon : CardUtils::cards_per_category(CardCategory::Weapon)) {
-			for (auto room : CardUtils::cards_per_category(CardCategory::Room)) {
-				if (!possible_solution_cards.at(CardCategory::Suspect).contains(suspect) || !possible_solution_cards.at(CardCategory::Weapon).contains(weapon) || !possible_solution_cards.at(CardCategory::Room).contains(room))
-					continue;
+	struct Candidate {
+		std::size_t solution_probability_index;
+		Solver solver;
+		std::vector<Card> unused_cards;
+	};
+
+	std::vector<Candidate> candidates;
 
-				auto solver_first_copy = *this;
+	for (auto suspect : suspects) {
+		for (auto weapon : weapons) {
+			for (auto room : rooms) {
+				solution_probabilities.emplace_back(std::make_tuple(suspect, weapon, room), 0);
+
+				// This solution contradicts what we know, so there's no need to sample it.
+				auto solver_first_copy = solver_for_solution(suspect, weapon, room);
+				if (!solver_first_copy)
+					continue;
 
 				std::vector<Card> unused_cards;
 				for (auto card : CardUtils::cards()) {
-					if (std::any_of(solver_first_copy.m_players.begin(), solver_first_copy.m_players.end(), [card](auto const& player) { return player.m_cards_in_hand.contains(card); }))
+					if (std::any_of(m_players.begin(), m_players.end(), [card](auto const& player) { return player.m_cards_in_hand.contains(card); }))
 						continue;
 
 					if (card == suspect || card == weapon || card == room)
@@ -291,30 +682,58 @@ std::vector<Solver::SolutionProbabilityPair> Solver::find_most_likely_solutions(
 					unused_cards.push_back(card);
 				}
 
-				solver_first_copy.learn_player_card_state(solver_first_copy.solution_player_index(), suspect, true, false);
-				solver_first_copy.learn_player_card_state(solver_first_copy.solution_player_index(), weapon, true, false);
-				solver_first_copy.learn_player_card_state(solver_first_copy.solution_player_index(), room, true, false);
-				solver_first_copy.infer_new_information();
+				candidates.push_back({ solution_probabilities.size() - 1, std::move(*solver_first_copy), std::move(unused_cards) });
+			}
+		}
+	}
 
-				std::size_t valid_iterations = 0;
-				for (std::size_t iteration = 0; iteration < max_iterations_per_solution; ++iteration) {
-					auto solver_second_copy = solver_first_copy;
+	// The solutions are sampled in turn, a few samples at a time, so that the
+	// progress gives a usable estimate of all of them from the first pass on.
+	for (std::size_t iteration = 0; iteration < max_iterations_per_solution && !stop_token.stop_requested(); iteration += SAMPLES_PER_PASS) {
+		auto pass_iterations = std::min(SAMPLES_PER_PASS, max_iterations_per_solution - iteration);
 
-					shuffle_cards(unused_cards, prng);
+		for (auto& candidate : candidates) {
+			if (stop_token.stop_requested())
+				break;
+
+			std::size_t valid_iterations = 0;
+			SolveProgress::CardOwnerCounts card_owner_counts {};
+			for (std::size_t pass_iteration = 0; pass_iteration < pass_iterations; ++pass_iteration) {
+				auto solver_second_copy = candidate.solver;
+
+				shuffle_cards(candidate.unused_cards, prng);
+
+				if (!solver_second_copy.assign_cards_to_players(candidate.unused_cards) || !solver_second_copy.are_constraints_satisfied_for_solution_search())
+					continue;
 
-					if (solver_second_copy.assign_cards_to_players(unused_cards) && solver_second_copy.are_constraints_satisfied_for_solution_search())
-						++valid_iterations;
+				++valid_iterations;
+
+				// A valid sample is a full deal, so it also tells who holds each card.
+				if (progress != nullptr) {
+					for (std::size_t player_index = 0; player_index < solver_second_copy.m_players.size(); ++player_index) {
+						for (auto card : solver_second_copy.m_players[player_index].m_cards_in_hand)
+							++card_owner_counts[player_index][static_cast<std::size_t>(card)];
+					}
 				}
+			}
 
-				solution_probabilities.emplace_back(std::make_tuple(suspect, weapon, room), valid_iterations);
+			auto& solution_probability = solution_probabilities.at(candidate.solution_probability_index);
+			solution_probability.second += valid_iterations;
+
+			if (progress != nullptr) {
+				auto [suspect, weapon, room] = solution_probability.first;
+				progress->add_samples(SolveProgress::solution_index(suspect, weapon, room), valid_iterations, pass_iterations, card_owner_counts);
 			}
 		}
 	}
 
 	auto total_iterations = std::accumulate(solution_probabilities.begin(), solution_probabilities.end(), 0.0f, [](auto const& accumulator, auto const& pair) { return accumulator + pair.second; });
 
-	for (auto& pair : solution_probabilities)
-		pair.second /= total_iterations;
+	// The search may have been stopped before any valid sample was taken.
+	if (total_iterations > 0) {
+		for (auto& pair : solution_probabilities)
+			pair.second /= total_iterations;
+	}
 
 	std::sort(solution_probabilities.begin(), solution_probabilities.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
 
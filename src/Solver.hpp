@@ -1,21 +1,41 @@
 #pragma once
 
 #include "CardSet.hpp"
+#include "DeductionRule.hpp"
 #include "Error.hpp"
 #include "Player.hpp"
 #include "utils/Result.hpp"
 
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <variant>
+
 /// \file Solver.hpp
 /// \brief The file that contains the definition of the \ref Cluedo::Solver class.
 
 namespace Cluedo {
 
+class SolveProgress;
+
 /// \brief A struct that contains the data of a player.
 struct PlayerData {
 	std::string name;       ///< The name of the player.
 	std::size_t card_count; ///< The number of cards held by the player.
 };
 
+/// \brief A struct that contains the options of a search for the most likely solutions.
+struct SearchOptions {
+	std::size_t max_sample_count { 1'000'000 }; ///< The number of samples to take, which are split evenly between the possible solutions.
+	std::optional<std::uint64_t> seed;          ///< The seed of the samples, or nothing to take different samples at every search.
+};
+
 /// \brief The solver of a Cluedo game.
 ///
 /// This class is the heart of the application. It contains the data of the game
@@ -81,6 +101,18 @@ public:
 		std::optional<Card> response_card;                  ///< The card with which the player responded, if known.
 	};
 
+	/// Checks if a suggestion can happen in a game.
+	///
+	/// A suggestion is valid if its players are in the game, the player who
+	/// responded isn't the one who made it, its cards are a suspect, a weapon
+	/// and a room, in this order, and the response card is one of them.
+	///
+	/// \param suggestion The suggestion.
+	/// \param player_count The number of players in the game.
+	///
+	/// \return `true` if the suggestion is valid, `false` otherwise.
+	static bool is_valid_suggestion(Suggestion const& suggestion, std::size_t player_count);
+
 	/// Learns from a suggestion.
 	/// \note This method will infer new information by default.
 	///
@@ -88,31 +120,209 @@ public:
 	/// \param infer_new_info `true` if new information should be inferred, `false` otherwise.
 	void learn_from_suggestion(Suggestion const& suggestion, bool infer_new_info = true);
 
+	/// \brief A struct that contains the information that a player has a card or not.
+	struct PlayerCardState {
+		std::size_t player_index; ///< The index of the player.
+		Card card;                ///< The card in question.
+		bool has_card;            ///< `true` if the player has the card, `false` otherwise.
+	};
+
+	/// \typedef Information
+	/// \brief A piece of information that can be learnt during a game.
+	using Information = std::variant<PlayerCardState, Suggestion>;
+
+	/// Learns a piece of information.
+	/// \note This method will infer new information by default.
+	///
+	/// \param information The information learnt in the game.
+	/// \param infer_new_info `true` if new information should be inferred, `false` otherwise.
+	void learn(Information const& information, bool infer_new_info = true);
+
+	/// Learns a sequence of information, each one in its own transaction.
+	/// \note This method stops at the first information that isn't valid.
+	/// \note This method will fail if a transaction is running.
+	///
+	/// \param informations The information to learn, in the order they were learnt in the game.
+	///
+	/// \return The number of information learnt.
+	std::size_t learn_in_transactions(std::span<Information const> informations);
+
+	/// \typedef DeductionRule
+	/// \brief The rules with which the solver infers new information, see \ref Cluedo::DeductionRule.
+	/// \note The rules are defined outside of the solver, since some of them are applied by the players.
+	using DeductionRule = Cluedo::DeductionRule;
+
+	/// \typedef DeductionCounts
+	/// \brief The number of facts inferred by each rule, see \ref Cluedo::DeductionCounts.
+	using DeductionCounts = Cluedo::DeductionCounts;
+
+	/// Returns the number of facts (a player having a card or not) inferred by each rule.
+	/// \note The counts start from zero when the solver is created or
+	/// snapshotted and aren't changed by rollbacks or undos, so they also count
+	/// what was inferred by the information that was then discarded.
+	///
+	/// \return The number of facts inferred by each rule.
+	DeductionCounts const& deduction_counts() const { return m_deduction_counts; }
+
 	/// Checks if the constraints of the game are satisfied.
 	bool are_constraints_satisfied() const;
 
+	/// Begins a transaction.
+	///
+	/// From now on, before a player is changed for the first time, its cards
+	/// are recorded on a trail so that the transaction can be rolled back or,
+	/// once committed, undone with \ref undo. This means that the memory used by
+	/// undo steps grows with the information learnt and not with the size of
+	/// the whole game.
+	///
+	/// While learning, the solver stops as soon as it finds a contradiction, so
+	/// rejecting invalid information only costs what was changed until then.
+	/// \note Changes made outside of a transaction can't be undone.
+	/// \note This function will fail if a transaction is already running.
+	void begin_transaction();
+	/// Commits the running transaction, which becomes an undo step.
+	/// \note If the constraints of the game aren't satisfied anymore the
+	/// transaction is rolled back instead.
+	///
+	/// \return `true` if the transaction was committed, `false` if it was rolled back.
+	bool commit_transaction();
+	/// Rolls back the running transaction, undoing all the changes made in it.
+	void rollback_transaction();
+	/// Undoes all the changes made in the last committed transaction.
+	/// \note This function will fail if there are no undo steps or a transaction is running.
+	void undo();
+	/// Returns the number of undo steps available.
+	///
+	/// \return The number of undo steps available.
+	std::size_t undo_step_count() const { return m_undo_marks.size() - m_in_transaction; }
+
+	/// Drops all the undo steps.
+	/// \note This function will fail if a transaction is running.
+	void clear_undo_steps();
+
+	/// Returns a copy of the solver without its undo steps.
+	/// \note This function will fail if a transaction is running.
+	///
+	/// \return The copy of the solver.
+	Solver snapshot() const;
+
+	/// Returns an estimate of the memory used by the solver.
+	/// \note The estimate counts the players and the undo steps, which are the
+	/// only parts of the solver that grow during a game.
+	///
+	/// \return The number of bytes used by the solver, including the ones of the object itself.
+	std::size_t memory_usage() const;
+
+	static constexpr std::uint8_t BINARY_VERSION = 1; ///< The version of the binary format of the state of the solver.
+
+	/// Converts the state of the solver, without its undo steps, into a compact binary format.
+	///
+	/// The format stores, with every integer little-endian:
+	/// * the magic `CLSV` and the version of the format (1 byte);
+	/// * the number of players (1 byte) and whether there is a contradiction (1 byte);
+	/// * for each player, its number of cards (1 byte), the length of its name (1 byte) and the UTF-8 name;
+	/// * for each player and then for the solution, the masks of the cards in
+	///   and not in hand (4 bytes each), the number of sets of possible cards
+	///   (2 bytes) and their masks (4 bytes each).
+	/// \note This function will fail if a transaction is running.
+	/// \note The state of a solver with a contradiction may be one that \ref from_binary rejects.
+	///
+	/// \return A \ref Result object that contains the binary data if the state
+	/// fits in the format or \ref Cluedo::Error::InvalidSolverState otherwise,
+	/// which happens if a name is longer than 255 bytes or a player has more than 255 cards.
+	Result<std::string, Error> to_binary() const;
+	/// Creates a solver from its state in the binary format.
+	///
+	/// The state isn't trusted: a state in which a card is held by two owners
+	/// or a player holds more cards than they have is rejected. The
+	/// contradiction check, which also checks the sets of possible cards
+	/// against what is known of the players, and the inference are then run
+	/// again, so the solver knows at least what was stored; a state stored
+	/// without a contradiction that turns out to have one is rejected too.
+	/// \see to_binary
+	///
+	/// \param data The binary data.
+	///
+	/// \return A \ref Result object that contains the solver if the data is
+	/// valid or \ref Cluedo::Error::InvalidSolverState otherwise.
+	static Result<Solver, Error> from_binary(std::string_view data);
+
 	/// \typedef SolutionProbabilityPair
 	/// \brief A pair that contains a solution (a suspect, a weapon and a room) and its probability.
 	using SolutionProbabilityPair = std::pair<std::tuple<Card, Card, Card>, float>;
 
+	/// \typedef CardOwnershipProbabilities
+	/// \brief The probabilities of each player holding each card.
+	///
+	/// The rows are indexed by the index of the player, with the solution as the
+	/// last one, and the columns by the card.
+	using CardOwnershipProbabilities = std::vector<std::array<float, CardUtils::CARD_COUNT>>;
+
 	/// Finds the most likely solutions for the game.
 	///
+	/// \param progress The object to which the samples are added while they are
+	/// taken, so that the estimates can be read before the search is over. The
+	/// owners of the cards in the valid samples are added to it too, which gives
+	/// the \ref CardOwnershipProbabilities of the game.
+	/// \param stop_token The token that is checked regularly to know if the
+	/// search has to stop early, in which case the solutions returned are based
+	/// only on the samples taken until then.
+	/// \param options The options of the search, with a seed the same search
+	/// always gives the same solutions.
+	///
 	/// \return The list of solutions ordered by their probability.
-	std::vector<SolutionProbabilityPair> find_most_likely_solutions() const;
+	std::vector<SolutionProbabilityPair> find_most_likely_solutions(SolveProgress* progress = nullptr, std::stop_token stop_token = {}, SearchOptions const& options = {}) const;
+
+	/// Returns the solutions that don't contradict what is known.
+	/// \note These are the solutions that \ref find_most_likely_solutions
+	/// samples, some of them may still turn out to have no valid deal.
+	///
+	/// \param max_solution_count The number of solutions after which the
+	/// search stops, which makes it fast to check if only a few are left.
+	///
+	/// \return The solutions, in the order of their cards.
+	std::vector<std::tuple<Card, Card, Card>> possible_solutions(std::size_t max_solution_count = std::numeric_limits<std::size_t>::max()) const;
 
 private:
-	static constexpr std::size_t MAX_ITERATIONS = 1'000'000;
+	static constexpr std::size_t SAMPLES_PER_PASS = 32;
 
 	explicit Solver(std::vector<Player>&& players)
-	  : m_players(std::move(players)) {}
+	  : m_players(std::move(players)), m_player_saved_undo_mark_serials(m_players.size(), 0) {}
 
 	std::size_t solution_player_index() const { return m_players.size() - 1; }
 
+	void save_player_for_undo(std::size_t player_index);
+	void check_player_for_contradictions(std::size_t player_index);
+	void restore_to_undo_mark();
+
 	void infer_new_information();
 	bool assign_cards_to_players(std::vector<Card> const& cards);
 	bool are_constraints_satisfied_for_solution_search() const;
+	std::array<CardSet, SOLUTION_CARD_COUNT> possible_solution_cards() const;
+	std::optional<Solver> solver_for_solution(Card suspect, Card weapon, Card room) const;
 
 	std::vector<Player> m_players;
+	bool m_has_contradiction { false };
+	DeductionCounts m_deduction_counts {};
+
+	struct TrailEntry {
+		std::size_t player_index;
+		CardSet cards_in_hand;
+		CardSet cards_not_in_hand;
+		std::vector<CardSet> possibilities;
+	};
+
+	struct UndoMark {
+		std::size_t trail_size;
+		std::size_t serial;
+		bool had_contradiction;
+	};
+
+	std::vector<TrailEntry> m_trail;
+	std::vector<UndoMark> m_undo_marks;
+	std::vector<std::size_t> m_player_saved_undo_mark_serials;
+	std::size_t m_next_undo_mark_serial { 1 };
+	bool m_in_transaction { false };
 };
 
 };
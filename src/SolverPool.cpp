@@ -0,0 +1,68 @@
+#include "SolverPool.hpp"
+
+#include <optional>
+
+namespace Cluedo {
+
+SolverPool::SolverPool(std::size_t thread_count) {
+	for (std::size_t i = 0; i < thread_count; ++i)
+		m_threads.emplace_back([this](std::stop_token stop_token) { run(stop_token); });
+}
+
+SolverPool::~SolverPool() {
+	for (auto& thread : m_threads)
+		thread.request_stop();
+	for (auto& thread : m_threads)
+		thread.join();
+
+	// Once the threads are over nothing else can take the solves still waiting.
+	SolveProgress progress;
+	for (auto& job : m_jobs) {
+		progress.reset(job.solver.player_count());
+		job.on_solved({}, progress, true);
+	}
+}
+
+void SolverPool::submit(Solver&& solver, std::stop_token stop_token, OnSolved on_solved) {
+	{
+		std::lock_guard lock(m_mutex);
+		m_jobs.push_back({ std::move(solver), std::move(stop_token), std::move(on_solved) });
+	}
+
+	m_job_condition.notify_one();
+}
+
+void SolverPool::run(std::stop_token stop_token) {
+	SolveProgress progress;
+
+	while (true) {
+		std::optional<Job> job;
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_job_condition.wait(lock, stop_token, [this] { return !m_jobs.empty(); }))
+				return;
+
+			job.emplace(std::move(m_jobs.front()));
+			m_jobs.pop_front();
+		}
+
+		// A solve stopped while it was waiting is dropped without sampling anything, so
+		// that the solves of a closed session don't hold up the ones queued after them.
+		if (job->stop_token.stop_requested()) {
+			progress.reset(job->solver.player_count());
+			job->on_solved({}, progress, true);
+			continue;
+		}
+
+		// The solve stops if either its own token or the one of the thread is stopped.
+		std::stop_source solve_stop_source;
+		std::stop_callback job_stop_callback(job->stop_token, [&solve_stop_source]() { solve_stop_source.request_stop(); });
+		std::stop_callback thread_stop_callback(stop_token, [&solve_stop_source]() { solve_stop_source.request_stop(); });
+
+		progress.reset(job->solver.player_count());
+		auto solutions = job->solver.find_most_likely_solutions(&progress, solve_stop_source.get_token());
+		job->on_solved(std::move(solutions), progress, solve_stop_source.stop_requested());
+	}
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "SolveProgress.hpp"
+#include "Solver.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+/// \file SolverPool.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::SolverPool class.
+
+namespace Cluedo {
+
+/// \brief A pool of threads that find the most likely solutions of many games.
+///
+/// Unlike \ref Cluedo::AsyncSolver, which only cares about the newest state of
+/// a single game, every solve submitted to the pool is carried out, in the
+/// order they were submitted, by the first thread that is free. This way many
+/// sessions can share the same threads.
+class SolverPool {
+public:
+	/// \typedef OnSolved
+	/// \brief The function called, from the thread of the pool, when a solve is over.
+	///
+	/// It's given the solutions and the progress of the solve, which also has the
+	/// owners of the cards, and whether the solve was stopped before it was over.
+	/// It's called even if the solve was stopped, either by its own token or
+	/// because the pool is being destroyed, in which case the solutions are based
+	/// only on the samples taken until then.
+	using OnSolved = std::function<void(std::vector<Solver::SolutionProbabilityPair>&&, SolveProgress const&, bool is_stopped)>;
+
+	/// Constructs the pool and starts its threads.
+	///
+	/// \param thread_count The number of threads of the pool.
+	explicit SolverPool(std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency()));
+	/// Destroys the pool, stopping the solves in progress.
+	/// \note The functions of the solves in progress and of the ones still waiting are called as if they were stopped.
+	~SolverPool();
+
+	SolverPool(SolverPool const&) = delete;
+	SolverPool& operator=(SolverPool const&) = delete;
+
+	/// Submits a solve to the pool.
+	///
+	/// \param solver The solver of the game to find the solutions of.
+	/// \param stop_token The token that stops the solve or, if it hasn't started
+	/// yet, skips it, in which case the function is called with no solutions.
+	/// \param on_solved The function to call when the solve is over.
+	void submit(Solver&& solver, std::stop_token stop_token, OnSolved on_solved);
+
+private:
+	void run(std::stop_token stop_token);
+
+	struct Job {
+		Solver solver;
+		std::stop_token stop_token;
+		OnSolved on_solved;
+	};
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_job_condition;
+	std::deque<Job> m_jobs;
+
+	// The threads are the last member so that they are stopped and joined before the others are destroyed.
+	std::vector<std::jthread> m_threads;
+};
+
+}
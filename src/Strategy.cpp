@@ -0,0 +1,174 @@
+#include "Strategy.hpp"
+
+using namespace std::literals;
+
+namespace Cluedo {
+
+static constexpr std::array built_in_strategy_names { "random"sv, "deductive"sv, "gambler"sv, "sampler"sv };
+
+static Card random_card(CardSet const& cards, GameRandom& random) {
+	auto index = random(static_cast<std::uint32_t>(cards.size()));
+	for (auto card : cards) {
+		if (index-- == 0)
+			return card;
+	}
+
+	std::unreachable();
+}
+
+// Returns the cards of each category that may still be in the solution, as far as the solver knows.
+static std::array<CardSet, Solver::SOLUTION_CARD_COUNT> possible_solution_cards(Solver const& solver) {
+	auto const& solution_player = solver.player(solver.player_count());
+	std::array<CardSet, Solver::SOLUTION_CARD_COUNT> cards;
+	for (std::size_t i = 0; i < CardUtils::card_categories.size(); ++i) {
+		for (auto card : CardUtils::cards_per_category(CardUtils::card_categories[i])) {
+			if (solution_player.has_card(card) != false)
+				cards[i].insert(card);
+		}
+	}
+
+	return cards;
+}
+
+static Card random_card_of_category(std::size_t category_index, GameRandom& random) {
+	CardSet cards;
+	for (auto card : CardUtils::cards_per_category(CardUtils::card_categories[category_index]))
+		cards.insert(card);
+
+	return random_card(cards, random);
+}
+
+static SolutionCards solution_cards(std::tuple<Card, Card, Card> const& solution) {
+	auto [suspect, weapon, room] = solution;
+	return { suspect, weapon, room };
+}
+
+// Chooses the card to show following the policy and remembers it among the ones already shown.
+static Card choose_card_to_show(CardSet const& cards, ResponsePolicy policy, CardSet& shown_cards, GameRandom& random) {
+	auto card = [&]() {
+		if (policy == ResponsePolicy::First)
+			return *cards.begin();
+
+		if (policy == ResponsePolicy::Repeat) {
+			auto cards_already_shown = CardSet::intersection(cards, shown_cards);
+			if (!cards_already_shown.empty())
+				return random_card(cards_already_shown, random);
+		}
+
+		return random_card(cards, random);
+	}();
+
+	shown_cards.insert(card);
+	return card;
+}
+
+void Strategy::begin_game(std::size_t, CardSet const&) {}
+
+std::span<std::string_view const> Strategy::built_in_names() {
+	return built_in_strategy_names;
+}
+
+std::unique_ptr<Strategy> Strategy::create(std::string_view name) {
+	if (name == "random"sv)
+		return std::make_unique<SolverStrategy>(std::string(name), SuggestionPolicy::Random, ResponsePolicy::Random);
+
+	if (name == "deductive"sv)
+		return std::make_unique<SolverStrategy>(std::string(name), SuggestionPolicy::Unknown, ResponsePolicy::Repeat);
+
+	if (name == "gambler"sv)
+		return std::make_unique<SolverStrategy>(std::string(name), SuggestionPolicy::Unknown, ResponsePolicy::Repeat, 2);
+
+	if (name == "sampler"sv)
+		return std::make_unique<SamplingStrategy>(std::string(name), 10'000, 0.9f);
+
+	return nullptr;
+}
+
+void SolverStrategy::begin_game(std::size_t, CardSet const&) {
+	m_shown_cards = {};
+}
+
+std::optional<SolutionCards> SolverStrategy::choose_accusation(Solver const& solver, GameRandom& random) {
+	// Finding one more solution than the strategy accuses with is enough to know that it doesn't accuse.
+	auto solutions = solver.possible_solutions(m_max_accusation_solution_count + 1);
+
+	// No solution is left only if the solver has a contradiction.
+	if (solutions.empty() || solutions.size() > m_max_accusation_solution_count)
+		return std::nullopt;
+
+	return solution_cards(solutions[random(static_cast<std::uint32_t>(solutions.size()))]);
+}
+
+SolutionCards SolverStrategy::choose_suggestion(Solver const& solver, GameRandom& random) {
+	auto cards = possible_solution_cards(solver);
+
+	SolutionCards suggestion;
+	for (std::size_t i = 0; i < CardUtils::card_categories.size(); ++i) {
+		// Every card of a category is ruled out only if the solver has a contradiction.
+		if (m_suggestion_policy == SuggestionPolicy::Random || cards[i].empty())
+			suggestion[i] = random_card_of_category(i, random);
+		else
+			suggestion[i] = random_card(cards[i], random);
+	}
+
+	return suggestion;
+}
+
+Card SolverStrategy::choose_response_card(CardSet const& cards, std::size_t, GameRandom& random) {
+	return choose_card_to_show(cards, m_response_policy, m_shown_cards, random);
+}
+
+void SamplingStrategy::begin_game(std::size_t, CardSet const&) {
+	m_shown_cards = {};
+	m_most_likely_solution.reset();
+}
+
+std::optional<SolutionCards> SamplingStrategy::choose_accusation(Solver const& solver, GameRandom& random) {
+	m_most_likely_solution.reset();
+
+	auto solutions = solver.possible_solutions(2);
+	if (solutions.size() == 1)
+		return solution_cards(solutions.front());
+
+	auto most_likely_solution = find_most_likely_solution(solver, random);
+	if (!most_likely_solution)
+		return std::nullopt;
+
+	auto [cards, probability] = *most_likely_solution;
+	if (probability >= m_min_accusation_probability)
+		return cards;
+
+	m_most_likely_solution = cards;
+	return std::nullopt;
+}
+
+SolutionCards SamplingStrategy::choose_suggestion(Solver const& solver, GameRandom& random) {
+	if (!m_most_likely_solution) {
+		if (auto most_likely_solution = find_most_likely_solution(solver, random))
+			m_most_likely_solution = most_likely_solution->first;
+	}
+
+	// No solution is left only if the solver has a contradiction.
+	if (!m_most_likely_solution)
+		return { random_card_of_category(0, random), random_card_of_category(1, random), random_card_of_category(2, random) };
+
+	return *std::exchange(m_most_likely_solution, std::nullopt);
+}
+
+Card SamplingStrategy::choose_response_card(CardSet const& cards, std::size_t, GameRandom& random) {
+	return choose_card_to_show(cards, ResponsePolicy::Repeat, m_shown_cards, random);
+}
+
+std::optional<std::pair<SolutionCards, float>> SamplingStrategy::find_most_likely_solution(Solver const& solver, GameRandom& random) const {
+	// The seed is drawn in two steps, since the order of the operands of an expression isn't specified.
+	std::uint64_t seed = random();
+	seed = (seed << 32) | random();
+
+	auto solutions = solver.find_most_likely_solutions(nullptr, {}, { .max_sample_count = m_sample_count, .seed = seed });
+	if (solutions.empty())
+		return std::nullopt;
+
+	return std::pair { solution_cards(solutions.front().first), solutions.front().second };
+}
+
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "CardSet.hpp"
+#include "Solver.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <pcg_random.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/// \file Strategy.hpp
+/// \brief The file that contains the definitions of the \ref Cluedo::Strategy interface and of the built-in strategies.
+
+namespace Cluedo {
+
+/// \typedef GameRandom
+/// \brief The generator of the random choices made in a simulated game.
+///
+/// Each game has its own generator, so that its choices only depend on its seed.
+using GameRandom = pcg32;
+
+/// \typedef SolutionCards
+/// \brief A suspect, a weapon and a room, in this order.
+using SolutionCards = std::array<Card, Solver::SOLUTION_CARD_COUNT>;
+
+/// \brief The interface of the players of a simulated game.
+///
+/// A strategy makes the decisions of a player based on what the player knows,
+/// that is their \ref Cluedo::Solver, which is fed with what they saw during
+/// the game. An object plays for a single player of a single game at a time,
+/// so it can keep its own state between the decisions, which is reset by
+/// \ref begin_game.
+class Strategy {
+public:
+	virtual ~Strategy() = default;
+
+	/// Returns the name of the strategy.
+	virtual std::string_view name() const = 0;
+
+	/// Prepares the strategy for a new game.
+	///
+	/// \param player_index The index of the player.
+	/// \param hand The cards held by the player.
+	virtual void begin_game(std::size_t player_index, CardSet const& hand);
+
+	/// Decides, at the start of the turn of the player, if they accuse.
+	/// \note A wrong accusation puts the player out of the game.
+	///
+	/// \param solver The solver of the player.
+	/// \param random The generator of the random choices.
+	///
+	/// \return The accusation or `std::nullopt` to make a suggestion instead.
+	virtual std::optional<SolutionCards> choose_accusation(Solver const& solver, GameRandom& random) = 0;
+
+	/// Chooses the suggestion of the player.
+	///
+	/// \param solver The solver of the player.
+	/// \param random The generator of the random choices.
+	///
+	/// \return The suggestion.
+	virtual SolutionCards choose_suggestion(Solver const& solver, GameRandom& random) = 0;
+
+	/// Chooses the card that the player shows in response to a suggestion.
+	///
+	/// \param cards The cards of the suggestion held by the player, which are at least one.
+	/// \param suggesting_player_index The index of the player who made the suggestion.
+	/// \param random The generator of the random choices.
+	///
+	/// \return One of the \a cards.
+	virtual Card choose_response_card(CardSet const& cards, std::size_t suggesting_player_index, GameRandom& random) = 0;
+
+	/// Returns the names of the built-in strategies.
+	static std::span<std::string_view const> built_in_names();
+
+	/// Creates a built-in strategy.
+	///
+	/// \param name The name of the strategy, one of \ref built_in_names.
+	///
+	/// \return The strategy or `nullptr` if there isn't one with the given name.
+	static std::unique_ptr<Strategy> create(std::string_view name);
+};
+
+/// \enum SuggestionPolicy
+/// \brief How a \ref Cluedo::SolverStrategy chooses its suggestions.
+enum class SuggestionPolicy : std::uint8_t {
+	Random,  ///< Any suspect, weapon and room.
+	Unknown, ///< The cards that, as far as the player knows, may still be in the solution.
+};
+
+/// \enum ResponsePolicy
+/// \brief Which card a \ref Cluedo::SolverStrategy shows when it can respond with more than one.
+enum class ResponsePolicy : std::uint8_t {
+	Random, ///< Any of them.
+	First,  ///< The first one, in the order of the cards.
+	Repeat, ///< One that was already shown before, to anyone, if there is one.
+};
+
+/// \brief A strategy that follows fixed policies and accuses as soon as few enough solutions are left.
+///
+/// The solutions left are the ones that don't contradict what the player
+/// knows, see \ref Cluedo::Solver::possible_solutions. The built-in strategies
+/// but `sampler` are of this kind:
+/// * `random` suggests any card, shows any card and only accuses when it knows the solution;
+/// * `deductive` suggests the cards that may be in the solution, shows the
+///   cards it already showed and only accuses when it knows the solution;
+/// * `gambler` plays like `deductive`, but it accuses as soon as only two
+///   solutions are left, taking one of them at random.
+class SolverStrategy final : public Strategy {
+public:
+	/// Constructs the strategy.
+	///
+	/// \param name The name of the strategy.
+	/// \param suggestion_policy How the strategy chooses its suggestions.
+	/// \param response_policy Which card the strategy shows.
+	/// \param max_accusation_solution_count The number of solutions, which
+	/// may still be the right one, at or below which the strategy accuses one
+	/// of them (1 means that it only accuses when it knows the solution).
+	SolverStrategy(std::string name, SuggestionPolicy suggestion_policy, ResponsePolicy response_policy, std::size_t max_accusation_solution_count = 1)
+	  : m_name(std::move(name)), m_suggestion_policy(suggestion_policy), m_response_policy(response_policy), m_max_accusation_solution_count(max_accusation_solution_count) {}
+
+	std::string_view name() const override { return m_name; }
+
+	void begin_game(std::size_t player_index, CardSet const& hand) override;
+	std::optional<SolutionCards> choose_accusation(Solver const& solver, GameRandom& random) override;
+	SolutionCards choose_suggestion(Solver const& solver, GameRandom& random) override;
+	Card choose_response_card(CardSet const& cards, std::size_t suggesting_player_index, GameRandom& random) override;
+
+private:
+	std::string m_name;
+	SuggestionPolicy m_suggestion_policy;
+	ResponsePolicy m_response_policy;
+	std::size_t m_max_accusation_solution_count;
+
+	CardSet m_shown_cards;
+};
+
+/// \brief A strategy that estimates how likely each solution is by sampling
+/// the deals that agree with what the player knows.
+///
+/// The strategy suggests the most likely solution, shows the cards it already
+/// showed and accuses when it knows the solution or when the most likely one
+/// is likely enough. The samples are seeded by the generator of the game, so
+/// the games still only depend on their seed.
+///
+/// The built-in `sampler` strategy is of this kind: it takes 10000 samples at
+/// every turn and accuses a solution that is at least 90% likely.
+class SamplingStrategy final : public Strategy {
+public:
+	/// Constructs the strategy.
+	///
+	/// \param name The name of the strategy.
+	/// \param sample_count The number of samples taken at every turn, see \ref Cluedo::SearchOptions::max_sample_count.
+	/// \param min_accusation_probability The probability of the most likely solution at or above which the strategy accuses it.
+	SamplingStrategy(std::string name, std::size_t sample_count, float min_accusation_probability)
+	  : m_name(std::move(name)), m_sample_count(sample_count), m_min_accusation_probability(min_accusation_probability) {}
+
+	std::string_view name() const override { return m_name; }
+
+	void begin_game(std::size_t player_index, CardSet const& hand) override;
+	std::optional<SolutionCards> choose_accusation(Solver const& solver, GameRandom& random) override;
+	SolutionCards choose_suggestion(Solver const& solver, GameRandom& random) override;
+	Card choose_response_card(CardSet const& cards, std::size_t suggesting_player_index, GameRandom& random) override;
+
+private:
+	std::optional<std::pair<SolutionCards, float>> find_most_likely_solution(Solver const& solver, GameRandom& random) const;
+
+	std::string m_name;
+	std::size_t m_sample_count;
+	float m_min_accusation_probability;
+
+	CardSet m_shown_cards;
+	// The solution found when deciding whether to accuse, which is then suggested in the same turn.
+	std::optional<SolutionCards> m_most_likely_solution;
+};
+
+}
@@ -0,0 +1,49 @@
+#include "ToolUtils.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fmt/color.h>
+#include <fmt/core.h>
+#include <fstream>
+#include <sstream>
+
+namespace Cluedo {
+
+int ToolUtils::run_main(int argc, char** argv, Main main) {
+	std::vector<std::string_view> arguments;
+	for (int i = 1; i < argc; ++i)
+		arguments.emplace_back(argv[i]);
+
+	auto maybe_error = main(std::move(arguments));
+	if (!maybe_error.is_error())
+		return EXIT_SUCCESS;
+
+	auto error = maybe_error.release_error();
+	fmt::println(stderr, "[{}] {}", fmt::styled("ERROR", fmt::fg(fmt::color::red)), error);
+	return EXIT_FAILURE;
+}
+
+bool ToolUtils::has_option(std::vector<std::string_view> const& arguments, std::string_view short_name, std::string_view long_name) {
+	return std::any_of(arguments.begin(), arguments.end(), [&](auto argument) { return argument == short_name || argument == long_name; });
+}
+
+std::optional<std::string> ToolUtils::read_file(std::string const& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return std::nullopt;
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	return stream.str();
+}
+
+bool ToolUtils::is_solution_determined(Solver const& solver) {
+	auto const& solution = solver.player(solver.player_count());
+	std::size_t known_card_count = 0;
+	for (auto card : CardUtils::cards())
+		known_card_count += solution.has_card(card) == true;
+
+	return known_card_count == Solver::SOLUTION_CARD_COUNT;
+}
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Solver.hpp"
+#include "utils/Result.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// \file ToolUtils.hpp
+/// \brief The file that contains the utilities shared by the command line tools.
+
+namespace Cluedo {
+
+/// \brief A series of utilities shared by the command line tools, which parse
+/// their arguments, read their inputs and write their outputs the same way.
+struct ToolUtils {
+	/// \typedef Main
+	/// \brief The function that runs a tool with its arguments, without the name of the program.
+	using Main = Result<void, std::string> (*)(std::vector<std::string_view>&& arguments);
+
+	/// The number of games that a thread of a tool takes at a time.
+	static constexpr std::size_t GAMES_PER_BATCH = 64;
+
+	/// Runs a tool, printing its error on the standard error if it fails.
+	///
+	/// \param argc The number of arguments given to `main`.
+	/// \param argv The arguments given to `main`.
+	/// \param main The function that runs the tool.
+	///
+	/// \return The exit code of the program.
+	static int run_main(int argc, char** argv, Main main);
+
+	/// Checks if an option that takes no value was given.
+	///
+	/// \param arguments The arguments of the tool.
+	/// \param short_name The short name of the option, like `-h`.
+	/// \param long_name The long name of the option, like `--help`.
+	///
+	/// \return `true` if either name is among the arguments.
+	static bool has_option(std::vector<std::string_view> const& arguments, std::string_view short_name, std::string_view long_name);
+
+	/// Parses a number, which must take the whole text.
+	///
+	/// \param text The text.
+	/// \param value Set to the number if it's valid.
+	///
+	/// \return `true` if the text is a valid number.
+	template<typename T>
+	static bool parse_number(std::string_view text, T& value) {
+		auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc {} && end == text.data() + text.size();
+	}
+
+	/// Reads a whole file.
+	///
+	/// \param path The path of the file.
+	///
+	/// \return The content of the file or `std::nullopt` if it couldn't be read.
+	static std::optional<std::string> read_file(std::string const& path);
+
+	/// Checks if the solver knows the card of each category in the solution.
+	///
+	/// \param solver The solver.
+	///
+	/// \return `true` if the solver knows the solution.
+	static bool is_solution_determined(Solver const& solver);
+
+	/// \brief A class that writes the outputs of items processed in parallel
+	/// in the order of their index, as soon as it's possible.
+	template<typename Output>
+	class OrderedWriter {
+	public:
+		/// \typedef Write
+		/// \brief The function that writes an output, which is called in the order of the indices.
+		using Write = std::function<void(Output&)>;
+
+		/// Constructs the writer.
+		///
+		/// \param write The function that writes an output.
+		explicit OrderedWriter(Write write)
+		  : m_write(std::move(write)) {}
+
+		/// Writes the output of an item, and those of the items after it that
+		/// were waiting for it, unless some items before it aren't written yet.
+		/// \note This method can be called from any thread, every index from
+		/// zero on must be written exactly once.
+		///
+		/// \param index The index of the item.
+		/// \param output The output of the item.
+		void write(std::size_t index, Output&& output) {
+			std::lock_guard lock(m_mutex);
+			m_pending_outputs.emplace(index, std::move(output));
+			for (auto it = m_pending_outputs.begin(); it != m_pending_outputs.end() && it->first == m_next_index; it = m_pending_outputs.erase(it), ++m_next_index)
+				m_write(it->second);
+		}
+
+	private:
+		std::mutex m_mutex;
+		Write m_write;
+		// Only the outputs of the items that were over before some of those before them are kept.
+		std::map<std::size_t, Output> m_pending_outputs;
+		std::size_t m_next_index { 0 };
+	};
+};
+
+}
@@ -0,0 +1,188 @@
+// Replays recorded games through the solver and writes their most likely solutions.
+//
+// Usage: cluedo-batch [options] <game records...>
+//
+// Every game record (see GameRecord.hpp), either in JSON or in the binary
+// format, is replayed on its own and the results are written as JSON lines,
+// in the order the records were given, while the records themselves are
+// replayed in parallel.
+
+#include "GameLog.hpp"
+#include "GameRecord.hpp"
+#include "JsonUtils.hpp"
+#include "SolveProgress.hpp"
+#include "ToolUtils.hpp"
+#include "utils/Result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fmt/core.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+using Cluedo::Json;
+using Cluedo::ToolUtils;
+
+static constexpr auto USAGE = R"(Usage: cluedo-batch [options] <game records...>
+
+Options:
+  -o, --output <file>  Write the results to a file instead of the standard output.
+  -s, --every-step     Write the solutions after every piece of information, not only at the end.
+  -j, --jobs <count>   Replay this many records at a time, by default as many as the cores.
+  -d, --dump           Write the records themselves as JSON instead of replaying them.
+  -h, --help           Show this message.
+)"sv;
+
+struct Options {
+	std::vector<std::string> record_paths;
+	std::optional<std::string> output_path;
+	bool every_step { false };
+	bool dump { false };
+	std::size_t job_count { std::max(1u, std::thread::hardware_concurrency()) };
+};
+
+static Result<Options, std::string> parse_arguments(std::vector<std::string_view> const& arguments) {
+	Options options;
+	for (std::size_t i = 0; i < arguments.size(); ++i) {
+		auto argument = arguments[i];
+		if (argument == "-o"sv || argument == "--output"sv) {
+			if (++i == arguments.size())
+				return fmt::format("missing file after '{}'", argument);
+
+			options.output_path = arguments[i];
+		} else if (argument == "-s"sv || argument == "--every-step"sv) {
+			options.every_step = true;
+		} else if (argument == "-d"sv || argument == "--dump"sv) {
+			options.dump = true;
+		} else if (argument == "-j"sv || argument == "--jobs"sv) {
+			if (++i == arguments.size())
+				return fmt::format("missing count after '{}'", argument);
+
+			if (!ToolUtils::parse_number(arguments[i], options.job_count) || options.job_count == 0)
+				return fmt::format("invalid number of jobs '{}'", arguments[i]);
+		} else if (argument.starts_with('-')) {
+			return fmt::format("unknown option '{}'", argument);
+		} else {
+			options.record_paths.emplace_back(argument);
+		}
+	}
+
+	if (options.record_paths.empty())
+		return "no game records given"s;
+
+	return options;
+}
+
+static Json estimate_to_json(Cluedo::Solver const& solver, Cluedo::SolveProgress& progress) {
+	progress.reset(solver.player_count());
+	auto solutions = solver.find_most_likely_solutions(&progress);
+	return Cluedo::JsonUtils::estimate_to_json(solutions, progress.card_ownership_probabilities());
+}
+
+// Replays a record and returns the lines to write for it and whether it could be replayed.
+static std::pair<std::string, bool> replay_record(std::string const& path, Options const& options, Cluedo::SolveProgress& progress) {
+	auto error_line = [&path](std::string_view error, std::optional<std::size_t> information_index = std::nullopt) {
+		Json line { { "record", path }, { "error", error } };
+		if (information_index)
+			line["information_index"] = *information_index;
+		return std::pair { line.dump() + '\n', false };
+	};
+
+	auto document = ToolUtils::read_file(path);
+	if (!document)
+		return error_line("couldn't read the file");
+
+	auto maybe_record = Cluedo::GameRecordView::is_binary(*document) ? Cluedo::GameRecord::from_binary(*document) : Cluedo::GameRecord::from_json(*document);
+	if (maybe_record.is_error())
+		return error_line(format_as(maybe_record.release_error()));
+
+	auto record = maybe_record.release_value();
+	if (options.dump)
+		return { record.to_json() + '\n', true };
+
+	auto maybe_solver = Cluedo::Solver::create(record.players);
+	if (maybe_solver.is_error())
+		return error_line(format_as(maybe_solver.release_error()));
+
+	std::string output;
+	auto write_step = [&](Cluedo::GameLog const& game_log) {
+		Json line { { "record", path }, { "step", game_log.informations().size() } };
+		line.update(estimate_to_json(game_log.solver(), progress));
+		output += line.dump();
+		output += '\n';
+	};
+
+	Cluedo::GameLog game_log(maybe_solver.release_value());
+	for (std::size_t i = 0; i < record.informations.size(); ++i) {
+		if (!game_log.append(record.informations[i]))
+			return error_line(format_as(Cluedo::Error::InvalidInformation), i);
+
+		if (options.every_step)
+			write_step(game_log);
+	}
+
+	if (!options.every_step || record.informations.empty())
+		write_step(game_log);
+
+	return { std::move(output), true };
+}
+
+Result<void, std::string> my_main(std::vector<std::string_view>&& arguments) {
+	if (ToolUtils::has_option(arguments, "-h"sv, "--help"sv)) {
+		fmt::print("{}", USAGE);
+		return {};
+	}
+
+	auto maybe_options = parse_arguments(arguments);
+	if (maybe_options.is_error())
+		return fmt::format("{}\n\n{}", maybe_options.release_error(), USAGE);
+
+	auto options = maybe_options.release_value();
+
+	std::FILE* output_file = stdout;
+	if (options.output_path) {
+		output_file = std::fopen(options.output_path->c_str(), "w");
+		if (output_file == nullptr)
+			return fmt::format("couldn't open '{}' for writing", *options.output_path);
+	}
+
+	// The outputs are written in the order the records were given, as soon as it's possible.
+	ToolUtils::OrderedWriter<std::string> writer([output_file](std::string& output) { std::fputs(output.c_str(), output_file); });
+	std::atomic<std::size_t> next_record_index { 0 };
+	std::atomic<std::size_t> failed_record_count { 0 };
+
+	{
+		std::vector<std::jthread> workers;
+		for (std::size_t i = 0; i < std::min(options.job_count, options.record_paths.size()); ++i) {
+			workers.emplace_back([&]() {
+				// The progress is only used to get the owners of the cards, so each worker reuses its own.
+				Cluedo::SolveProgress progress;
+				for (auto index = next_record_index++; index < options.record_paths.size(); index = next_record_index++) {
+					auto [output, is_replayed] = replay_record(options.record_paths[index], options, progress);
+					if (!is_replayed)
+						++failed_record_count;
+
+					writer.write(index, std::move(output));
+				}
+			});
+		}
+	}
+
+	if (output_file != stdout && std::fclose(output_file) != 0)
+		return fmt::format("couldn't write '{}'", *options.output_path);
+
+	if (failed_record_count > 0)
+		return fmt::format("{} of {} game records couldn't be replayed", failed_record_count.load(), options.record_paths.size());
+
+	return {};
+}
+
+int main(int argc, char** argv) {
+	return ToolUtils::run_main(argc, argv, my_main);
+}
@@ -0,0 +1,252 @@
+#include "cluedo.h"
+
+#include "GameLog.hpp"
+#include "GameRecord.hpp"
+#include "SolveProgress.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <optional>
+
+using namespace Cluedo;
+
+// The cards of the C interface are the values of the Card enum.
+static_assert(CLUEDO_CARD_COUNT == CardUtils::CARD_COUNT);
+static_assert(CLUEDO_CARD_SCARLET == static_cast<cluedo_card>(Card::Scarlet));
+static_assert(CLUEDO_CARD_WRENCH == static_cast<cluedo_card>(Card::Wrench));
+static_assert(CLUEDO_CARD_STUDY == static_cast<cluedo_card>(Card::Study));
+
+struct cluedo_solver {
+	GameLog game_log;
+};
+
+static cluedo_status to_status(Error error) {
+	switch (error) {
+	case Error::InvalidNumberOfPlayers:
+		return CLUEDO_ERROR_INVALID_NUMBER_OF_PLAYERS;
+	case Error::InvalidNumberOfCards:
+		return CLUEDO_ERROR_INVALID_NUMBER_OF_CARDS;
+	case Error::InvalidInformation:
+		return CLUEDO_ERROR_INVALID_INFORMATION;
+	case Error::InvalidGameRecord:
+		return CLUEDO_ERROR_INVALID_GAME_RECORD;
+	default:
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+	}
+}
+
+// Runs the body of a function, making sure that no exception crosses the C interface.
+template<typename Function>
+static cluedo_status guarded(Function&& function) {
+	try {
+		return function();
+	} catch (std::bad_alloc const&) {
+		return CLUEDO_ERROR_OUT_OF_MEMORY;
+	} catch (...) {
+		// The only other exceptions come from the JSON library, for names that aren't valid UTF-8.
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+	}
+}
+
+static std::optional<Card> to_card(cluedo_card card) {
+	if (card < 0 || card >= CLUEDO_CARD_COUNT)
+		return std::nullopt;
+
+	return static_cast<Card>(card);
+}
+
+static cluedo_status create_solver(std::vector<PlayerData> const& players, std::span<Solver::Information const> informations, cluedo_solver** solver) {
+	auto maybe_solver = Solver::create(players);
+	if (maybe_solver.is_error())
+		return to_status(maybe_solver.release_error());
+
+	auto handle = std::make_unique<cluedo_solver>(GameLog(maybe_solver.release_value()));
+	if (handle->game_log.append(informations) != informations.size())
+		return CLUEDO_ERROR_INVALID_INFORMATION;
+
+	*solver = handle.release();
+	return CLUEDO_OK;
+}
+
+static GameRecord to_record(GameLog const& game_log) {
+	auto const& solver = game_log.solver();
+	GameRecord record;
+	for (std::size_t i = 0; i < solver.player_count(); ++i)
+		record.players.push_back({ solver.player(i).name(), solver.player(i).card_count() });
+
+	auto informations = game_log.informations();
+	record.informations.assign(informations.begin(), informations.end());
+	return record;
+}
+
+static cluedo_status copy_to_buffer(std::string const& data, char* buffer, size_t buffer_size, size_t* size) {
+	*size = data.size();
+	if (buffer == nullptr || buffer_size < data.size())
+		return CLUEDO_ERROR_BUFFER_TOO_SMALL;
+
+	std::memcpy(buffer, data.data(), data.size());
+	return CLUEDO_OK;
+}
+
+static cluedo_status learn(cluedo_solver* solver, Solver::Information const& information) {
+	return solver->game_log.append(information) ? CLUEDO_OK : CLUEDO_ERROR_INVALID_INFORMATION;
+}
+
+extern "C" {
+
+uint32_t cluedo_abi_version(void) {
+	return CLUEDO_ABI_VERSION;
+}
+
+cluedo_status cluedo_solver_create(cluedo_player_data const* players, size_t player_count, cluedo_solver** solver) {
+	if ((players == nullptr && player_count > 0) || solver == nullptr)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() {
+		std::vector<PlayerData> players_data;
+		for (std::size_t i = 0; i < player_count; ++i)
+			players_data.push_back({ players[i].name != nullptr ? players[i].name : "", players[i].card_count });
+
+		return create_solver(players_data, {}, solver);
+	});
+}
+
+void cluedo_solver_destroy(cluedo_solver* solver) {
+	delete solver;
+}
+
+size_t cluedo_solver_player_count(cluedo_solver const* solver) {
+	return solver != nullptr ? solver->game_log.solver().player_count() : 0;
+}
+
+size_t cluedo_solver_information_count(cluedo_solver const* solver) {
+	return solver != nullptr ? solver->game_log.informations().size() : 0;
+}
+
+cluedo_status cluedo_solver_card_state(cluedo_solver const* solver, size_t player_index, cluedo_card card, cluedo_card_state* state) {
+	auto maybe_card = to_card(card);
+	if (solver == nullptr || state == nullptr || !maybe_card || player_index >= solver->game_log.solver().player_count())
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	auto has_card = solver->game_log.solver().player(player_index).has_card(*maybe_card);
+	*state = !has_card ? CLUEDO_CARD_STATE_UNKNOWN : *has_card ? CLUEDO_CARD_STATE_HAS : CLUEDO_CARD_STATE_HASNT;
+	return CLUEDO_OK;
+}
+
+cluedo_status cluedo_solver_learn_player_card_state(cluedo_solver* solver, size_t player_index, cluedo_card card, bool has_card) {
+	auto maybe_card = to_card(card);
+	if (solver == nullptr || !maybe_card || player_index >= solver->game_log.solver().player_count())
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() { return learn(solver, Solver::PlayerCardState { player_index, *maybe_card, has_card }); });
+}
+
+cluedo_status cluedo_solver_learn_from_suggestion(cluedo_solver* solver, cluedo_suggestion const* suggestion) {
+	if (solver == nullptr || suggestion == nullptr)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	auto player_count = solver->game_log.solver().player_count();
+	auto is_player_index_valid = [player_count](int32_t index) { return index >= 0 && static_cast<std::size_t>(index) < player_count; };
+	auto suspect = to_card(suggestion->suspect);
+	auto weapon = to_card(suggestion->weapon);
+	auto room = to_card(suggestion->room);
+	if (!is_player_index_valid(suggestion->suggesting_player_index) || !suspect || !weapon || !room)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	Solver::Suggestion information { static_cast<std::size_t>(suggestion->suggesting_player_index), *suspect, *weapon, *room, std::nullopt, std::nullopt };
+	if (suggestion->responding_player_index != CLUEDO_NONE) {
+		if (!is_player_index_valid(suggestion->responding_player_index))
+			return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+		information.responding_player_index = static_cast<std::size_t>(suggestion->responding_player_index);
+	}
+
+	if (suggestion->response_card != CLUEDO_NONE) {
+		information.response_card = to_card(suggestion->response_card);
+		if (!information.response_card)
+			return CLUEDO_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (!Solver::is_valid_suggestion(information, player_count))
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() { return learn(solver, information); });
+}
+
+cluedo_status cluedo_solver_undo(cluedo_solver* solver) {
+	if (solver == nullptr || solver->game_log.informations().empty())
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() {
+		solver->game_log.remove_last();
+		return CLUEDO_OK;
+	});
+}
+
+cluedo_status cluedo_solver_find_most_likely_solutions(cluedo_solver const* solver, cluedo_solution* solutions, size_t solution_capacity, size_t* solution_count, float* card_ownership) {
+	if (solver == nullptr || (solutions == nullptr && solution_capacity > 0) || solution_count == nullptr)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() {
+		auto const& game_solver = solver->game_log.solver();
+
+		// The owners of the cards are only counted if they are asked for.
+		std::optional<SolveProgress> progress;
+		if (card_ownership != nullptr)
+			progress.emplace().reset(game_solver.player_count());
+
+		auto most_likely_solutions = game_solver.find_most_likely_solutions(progress ? &*progress : nullptr);
+
+		*solution_count = std::min(solution_capacity, most_likely_solutions.size());
+		for (std::size_t i = 0; i < *solution_count; ++i) {
+			auto const& [solution, probability] = most_likely_solutions[i];
+			auto const& [suspect, weapon, room] = solution;
+			solutions[i] = { static_cast<cluedo_card>(suspect), static_cast<cluedo_card>(weapon), static_cast<cluedo_card>(room), probability };
+		}
+
+		if (progress) {
+			for (auto const& row : progress->card_ownership_probabilities())
+				card_ownership = std::copy(row.begin(), row.end(), card_ownership);
+		}
+
+		return CLUEDO_OK;
+	});
+}
+
+cluedo_status cluedo_solver_serialize(cluedo_solver const* solver, char* buffer, size_t buffer_size, size_t* size) {
+	if (solver == nullptr || size == nullptr)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() { return copy_to_buffer(to_record(solver->game_log).to_json(), buffer, buffer_size, size); });
+}
+
+cluedo_status cluedo_solver_serialize_binary(cluedo_solver const* solver, char* buffer, size_t buffer_size, size_t* size) {
+	if (solver == nullptr || size == nullptr)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() {
+		auto maybe_data = to_record(solver->game_log).to_binary();
+		if (maybe_data.is_error())
+			return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+		return copy_to_buffer(maybe_data.release_value(), buffer, buffer_size, size);
+	});
+}
+
+cluedo_status cluedo_solver_deserialize(char const* data, size_t size, cluedo_solver** solver) {
+	if ((data == nullptr && size > 0) || solver == nullptr)
+		return CLUEDO_ERROR_INVALID_ARGUMENT;
+
+	return guarded([&]() {
+		std::string_view document(data, size);
+		auto maybe_record = GameRecordView::is_binary(document) ? GameRecord::from_binary(document) : GameRecord::from_json(document);
+		if (maybe_record.is_error())
+			return to_status(maybe_record.release_error());
+
+		auto record = maybe_record.release_value();
+		return create_solver(record.players, record.informations, solver);
+	});
+}
+
+}
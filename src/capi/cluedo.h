@@ -0,0 +1,202 @@
+#pragma once
+
+/// \file cluedo.h
+/// \brief The C interface of the solver, exported by the `libcluedo` shared library.
+///
+/// The interface only uses C types and an opaque handle, so that the solver
+/// can be used from any language with a foreign function interface. Its ABI
+/// only changes along with \ref CLUEDO_ABI_VERSION.
+///
+/// The functions never allocate memory that the caller has to free: the
+/// results are written into buffers given by the caller. They also never
+/// throw or abort on invalid arguments, they return a \ref cluedo_status
+/// instead.
+///
+/// The functions that take a `const` handle can be called from many threads
+/// at once on the same handle, while the others need the handle all for
+/// themselves.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#	if defined(CLUEDO_BUILDING_LIBRARY)
+#		define CLUEDO_API __declspec(dllexport)
+#	else
+#		define CLUEDO_API __declspec(dllimport)
+#	endif
+#else
+#	define CLUEDO_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The version of the ABI described by this header.
+#define CLUEDO_ABI_VERSION 1
+
+/// \typedef cluedo_status
+/// \brief The result of a function, which is \ref CLUEDO_OK or one of the errors below.
+typedef int32_t cluedo_status;
+
+#define CLUEDO_OK 0                                ///< The function succeeded.
+#define CLUEDO_ERROR_INVALID_ARGUMENT 1            ///< An argument is out of range or a required pointer is `NULL`.
+#define CLUEDO_ERROR_INVALID_NUMBER_OF_PLAYERS 2   ///< The number of players isn't between 2 and 6.
+#define CLUEDO_ERROR_INVALID_NUMBER_OF_CARDS 3     ///< The cards of the players don't add up to the cards that aren't in the solution.
+#define CLUEDO_ERROR_INVALID_INFORMATION 4         ///< The information contradicts what was learnt before.
+#define CLUEDO_ERROR_INVALID_GAME_RECORD 5         ///< The serialized game isn't valid.
+#define CLUEDO_ERROR_BUFFER_TOO_SMALL 6            ///< The buffer given is too small for the result.
+#define CLUEDO_ERROR_OUT_OF_MEMORY 7               ///< The solver ran out of memory.
+
+/// \typedef cluedo_card
+/// \brief A card of the game, one of the `CLUEDO_CARD_*` values.
+typedef int32_t cluedo_card;
+
+#define CLUEDO_CARD_GREEN 0
+#define CLUEDO_CARD_MUSTARD 1
+#define CLUEDO_CARD_ORCHID 2
+#define CLUEDO_CARD_PEACOCK 3
+#define CLUEDO_CARD_PLUM 4
+#define CLUEDO_CARD_SCARLET 5
+#define CLUEDO_CARD_CANDLESTICK 6
+#define CLUEDO_CARD_KNIFE 7
+#define CLUEDO_CARD_PIPE 8
+#define CLUEDO_CARD_PISTOL 9
+#define CLUEDO_CARD_ROPE 10
+#define CLUEDO_CARD_WRENCH 11
+#define CLUEDO_CARD_BILLIARD_ROOM 12
+#define CLUEDO_CARD_BALLROOM 13
+#define CLUEDO_CARD_DINING_ROOM 14
+#define CLUEDO_CARD_GREENHOUSE 15
+#define CLUEDO_CARD_HALL 16
+#define CLUEDO_CARD_KITCHEN 17
+#define CLUEDO_CARD_LIBRARY 18
+#define CLUEDO_CARD_LOUNGE 19
+#define CLUEDO_CARD_STUDY 20
+#define CLUEDO_CARD_COUNT 21 ///< The number of cards.
+
+/// \typedef cluedo_card_state
+/// \brief What is known about a player holding a card, one of the `CLUEDO_CARD_STATE_*` values.
+typedef int32_t cluedo_card_state;
+
+#define CLUEDO_CARD_STATE_UNKNOWN 0 ///< It's not known if the player has the card.
+#define CLUEDO_CARD_STATE_HAS 1     ///< The player has the card.
+#define CLUEDO_CARD_STATE_HASNT 2   ///< The player hasn't got the card.
+
+/// Used in place of a player index or a card when it isn't known.
+#define CLUEDO_NONE (-1)
+
+/// \typedef cluedo_solver
+/// \brief The opaque handle of the solver of a game.
+typedef struct cluedo_solver cluedo_solver;
+
+/// \brief The data of a player.
+typedef struct cluedo_player_data {
+	char const* name;  ///< The name of the player, as a null-terminated UTF-8 string, or `NULL`.
+	size_t card_count; ///< The number of cards held by the player.
+} cluedo_player_data;
+
+/// \brief A suggestion made during the game.
+typedef struct cluedo_suggestion {
+	int32_t suggesting_player_index; ///< The index of the player who made the suggestion.
+	cluedo_card suspect;             ///< The suspect suggested.
+	cluedo_card weapon;              ///< The weapon suggested.
+	cluedo_card room;                ///< The room suggested.
+	int32_t responding_player_index; ///< The index of the player who responded or \ref CLUEDO_NONE if no one did.
+	cluedo_card response_card;       ///< The card with which the player responded or \ref CLUEDO_NONE if it isn't known.
+} cluedo_suggestion;
+
+/// \brief A possible solution of the game and its probability.
+typedef struct cluedo_solution {
+	cluedo_card suspect; ///< The suspect of the solution.
+	cluedo_card weapon;  ///< The weapon of the solution.
+	cluedo_card room;    ///< The room of the solution.
+	float probability;   ///< The probability of the solution.
+} cluedo_solution;
+
+/// Returns the version of the ABI of the library, which must match \ref CLUEDO_ABI_VERSION.
+CLUEDO_API uint32_t cluedo_abi_version(void);
+
+/// Creates the solver of a new game.
+///
+/// \param players The data of the players, in the order they play.
+/// \param player_count The number of players.
+/// \param solver Where the handle of the solver is written, which has to be destroyed with \ref cluedo_solver_destroy.
+CLUEDO_API cluedo_status cluedo_solver_create(cluedo_player_data const* players, size_t player_count, cluedo_solver** solver);
+/// Destroys a solver.
+///
+/// \param solver The solver, which can be `NULL`.
+CLUEDO_API void cluedo_solver_destroy(cluedo_solver* solver);
+
+/// Returns the number of players in the game.
+CLUEDO_API size_t cluedo_solver_player_count(cluedo_solver const* solver);
+/// Returns the number of pieces of information learnt.
+CLUEDO_API size_t cluedo_solver_information_count(cluedo_solver const* solver);
+/// Gets what is known about a player holding a card.
+///
+/// \param solver The solver.
+/// \param player_index The index of the player.
+/// \param card The card.
+/// \param state Where the state of the card is written.
+CLUEDO_API cluedo_status cluedo_solver_card_state(cluedo_solver const* solver, size_t player_index, cluedo_card card, cluedo_card_state* state);
+
+/// Learns that a player has a card or not.
+/// \note If the information contradicts what was learnt before, the solver is left untouched.
+///
+/// \param solver The solver.
+/// \param player_index The index of the player.
+/// \param card The card in question.
+/// \param has_card `true` if the player has the card, `false` otherwise.
+CLUEDO_API cluedo_status cluedo_solver_learn_player_card_state(cluedo_solver* solver, size_t player_index, cluedo_card card, bool has_card);
+/// Learns from a suggestion.
+/// \note If the information contradicts what was learnt before, the solver is left untouched.
+/// \note The suggestion must be one that can happen in a game: its cards must
+/// be a suspect, a weapon and a room, in this order, the response card, if
+/// any, must be one of them and the responding player, if any, must not be
+/// the one who made the suggestion. Otherwise `CLUEDO_ERROR_INVALID_ARGUMENT`
+/// is returned and nothing is learnt.
+///
+/// \param solver The solver.
+/// \param suggestion The suggestion.
+CLUEDO_API cluedo_status cluedo_solver_learn_from_suggestion(cluedo_solver* solver, cluedo_suggestion const* suggestion);
+/// Forgets the last piece of information learnt.
+/// \note This function fails with \ref CLUEDO_ERROR_INVALID_ARGUMENT if nothing was learnt.
+CLUEDO_API cluedo_status cluedo_solver_undo(cluedo_solver* solver);
+
+/// Finds the most likely solutions of the game.
+///
+/// \param solver The solver.
+/// \param solutions The buffer where the most likely solutions are written, ordered by their probability.
+/// \param solution_capacity The number of solutions that fit in the buffer, only the most likely ones are written if there are more.
+/// \param solution_count Where the number of solutions written is written.
+/// \param card_ownership The buffer where the probabilities of each player
+/// holding each card are written, or `NULL`. It must fit
+/// `(player_count + 1) * CLUEDO_CARD_COUNT` values: a row of \ref CLUEDO_CARD_COUNT
+/// values for each player and a last one for the solution.
+CLUEDO_API cluedo_status cluedo_solver_find_most_likely_solutions(cluedo_solver const* solver, cluedo_solution* solutions, size_t solution_capacity, size_t* solution_count, float* card_ownership);
+
+/// Serializes the game, that is its players and the information learnt, as a JSON game record.
+/// \note Call it with a `NULL` buffer to get the size needed.
+///
+/// \param solver The solver.
+/// \param buffer The buffer where the game is written, without a null terminator.
+/// \param buffer_size The size of the buffer in bytes.
+/// \param size Where the size of the serialized game is written, even if the
+/// buffer is too small, in which case \ref CLUEDO_ERROR_BUFFER_TOO_SMALL is returned.
+CLUEDO_API cluedo_status cluedo_solver_serialize(cluedo_solver const* solver, char* buffer, size_t buffer_size, size_t* size);
+/// Serializes the game like \ref cluedo_solver_serialize, but in the compact binary format of the game records.
+/// \note A game can only be serialized if the names of its players are at
+/// most 255 bytes long, otherwise \ref CLUEDO_ERROR_INVALID_ARGUMENT is returned.
+CLUEDO_API cluedo_status cluedo_solver_serialize_binary(cluedo_solver const* solver, char* buffer, size_t buffer_size, size_t* size);
+/// Creates a solver from a game serialized by \ref cluedo_solver_serialize or \ref cluedo_solver_serialize_binary.
+///
+/// \param data The serialized game.
+/// \param size The size of the serialized game in bytes.
+/// \param solver Where the handle of the solver is written, which has to be destroyed with \ref cluedo_solver_destroy.
+CLUEDO_API cluedo_status cluedo_solver_deserialize(char const* data, size_t size, cluedo_solver** solver);
+
+#ifdef __cplusplus
+}
+#endif
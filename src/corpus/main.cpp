@@ -0,0 +1,311 @@
+// Packs game records into a corpus and computes statistics over all of its games.
+//
+// Usage: cluedo-corpus pack <corpus> <game records...>
+//        cluedo-corpus stats [options] <corpus>
+//
+// `pack` converts the game records (see GameRecord.hpp), either in JSON or in
+// the binary format, into a single corpus file (see GameCorpus.hpp).
+//
+// `stats` replays every game of a corpus through the solver and writes, as
+// JSON, how many suggestions it took to determine the solution and how often
+// each deduction rule of the solver found something new at every turn. The
+// index of the corpus is split into a shard per thread and the corpus is
+// memory-mapped, so the games are read in place without opening or parsing
+// any file per game.
+
+#include "GameCorpus.hpp"
+#include "JsonUtils.hpp"
+#include "ToolUtils.hpp"
+#include "utils/Result.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fmt/core.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+using Cluedo::Json;
+using Cluedo::ToolUtils;
+
+static constexpr auto USAGE = R"(Usage: cluedo-corpus pack <corpus> <game records...>
+       cluedo-corpus stats [options] <corpus>
+
+Commands:
+  pack                 Pack the game records, in JSON or in the binary format, into a corpus.
+  stats                Replay the games of a corpus and write statistics about them as JSON.
+
+Options:
+  -j, --jobs <count>   Replay this many shards of the corpus at a time, by default as many as the cores.
+  -h, --help           Show this message.
+)"sv;
+
+static constexpr std::array deduction_rule_names { "OwnedCard"sv, "LastPossibleOwner"sv, "SolutionCategory"sv, "SharedPossibilities"sv, "SinglePossibility"sv, "FullHand"sv };
+static_assert(deduction_rule_names.size() == std::tuple_size_v<Cluedo::Solver::DeductionCounts>);
+
+static Result<void, std::string> pack(std::string const& corpus_path, std::vector<std::string_view> const& record_paths) {
+	auto maybe_writer = Cluedo::GameCorpusWriter::create(corpus_path);
+	if (maybe_writer.is_error())
+		return fmt::format("couldn't create '{}'", corpus_path);
+
+	auto writer = maybe_writer.release_value();
+	for (auto record_path : record_paths) {
+		auto document = ToolUtils::read_file(std::string(record_path));
+		if (!document)
+			return fmt::format("couldn't read '{}'", record_path);
+
+		// The records already in the binary format are checked but not converted.
+		if (Cluedo::GameRecordView::is_binary(*document)) {
+			if (Cluedo::GameRecordView::from_binary(*document).is_error())
+				return fmt::format("'{}' isn't a valid game record", record_path);
+		} else {
+			auto maybe_record = Cluedo::GameRecord::from_json(*document);
+			auto maybe_binary = maybe_record.is_value() ? maybe_record.release_value().to_binary() : Cluedo::Error::InvalidGameRecord;
+			if (maybe_binary.is_error())
+				return fmt::format("'{}' isn't a valid game record or can't be converted to the binary format", record_path);
+
+			document = maybe_binary.release_value();
+		}
+
+		if (writer.append(*document).is_error())
+			return fmt::format("couldn't write '{}'", corpus_path);
+	}
+
+	if (writer.finish().is_error())
+		return fmt::format("couldn't write '{}'", corpus_path);
+
+	return {};
+}
+
+// The statistics of some games, which are computed for each shard and then merged.
+struct Statistics {
+	std::size_t game_count { 0 };
+	std::size_t invalid_game_count { 0 };
+
+	// The number of games whose solution was determined after each number of suggestions.
+	std::vector<std::size_t> suggestions_until_determined;
+
+	struct Turn {
+		std::size_t game_count { 0 };
+		std::array<std::size_t, deduction_rule_names.size()> hit_count {}; // The games in which the rule found something.
+		std::array<std::size_t, deduction_rule_names.size()> fact_count {};
+	};
+
+	std::vector<Turn> turns;
+
+	// The number of facts found by each rule at each turn of the game being added, kept to reuse its memory.
+	std::vector<Cluedo::Solver::DeductionCounts> game_fact_counts;
+
+	void add_game(Cluedo::GameRecordView const& record);
+	void merge(Statistics const& other);
+	Json to_json() const;
+};
+
+void Statistics::add_game(Cluedo::GameRecordView const& record) {
+	++game_count;
+
+	std::vector<Cluedo::PlayerData> players;
+	for (std::size_t i = 0; i < record.player_count(); ++i)
+		players.push_back({ std::string(record.player_name(i)), record.player_card_count(i) });
+
+	auto maybe_solver = Cluedo::Solver::create(players);
+	if (maybe_solver.is_error()) {
+		++invalid_game_count;
+		return;
+	}
+
+	auto solver = maybe_solver.release_value();
+	std::optional<std::size_t> suggestions_until_solution_determined;
+	std::size_t suggestion_count = 0;
+	// The facts found at each turn are only added to the statistics if the whole game is valid.
+	game_fact_counts.clear();
+	for (std::size_t i = 0; i < record.information_count(); ++i) {
+		auto information = record.information(i);
+		auto deduction_counts = solver.deduction_counts();
+
+		solver.begin_transaction();
+		solver.learn(information);
+		if (!solver.commit_transaction()) {
+			++invalid_game_count;
+			return;
+		}
+
+		// The undo steps aren't needed, so they don't have to pile up.
+		solver.clear_undo_steps();
+
+		auto& fact_counts = game_fact_counts.emplace_back();
+		for (std::size_t rule = 0; rule < fact_counts.size(); ++rule)
+			fact_counts[rule] = solver.deduction_counts()[rule] - deduction_counts[rule];
+
+		if (std::holds_alternative<Cluedo::Solver::Suggestion>(information))
+			++suggestion_count;
+
+		if (!suggestions_until_solution_determined && ToolUtils::is_solution_determined(solver))
+			suggestions_until_solution_determined = suggestion_count;
+	}
+
+	if (turns.size() < game_fact_counts.size())
+		turns.resize(game_fact_counts.size());
+
+	for (std::size_t i = 0; i < game_fact_counts.size(); ++i) {
+		++turns[i].game_count;
+		for (std::size_t rule = 0; rule < deduction_rule_names.size(); ++rule) {
+			turns[i].hit_count[rule] += game_fact_counts[i][rule] > 0;
+			turns[i].fact_count[rule] += game_fact_counts[i][rule];
+		}
+	}
+
+	if (suggestions_until_solution_determined) {
+		if (suggestions_until_determined.size() <= *suggestions_until_solution_determined)
+			suggestions_until_determined.resize(*suggestions_until_solution_determined + 1);
+
+		++suggestions_until_determined[*suggestions_until_solution_determined];
+	}
+}
+
+void Statistics::merge(Statistics const& other) {
+	game_count += other.game_count;
+	invalid_game_count += other.invalid_game_count;
+
+	suggestions_until_determined.resize(std::max(suggestions_until_determined.size(), other.suggestions_until_determined.size()));
+	for (std::size_t i = 0; i < other.suggestions_until_determined.size(); ++i)
+		suggestions_until_determined[i] += other.suggestions_until_determined[i];
+
+	turns.resize(std::max(turns.size(), other.turns.size()));
+	for (std::size_t i = 0; i < other.turns.size(); ++i) {
+		turns[i].game_count += other.turns[i].game_count;
+		for (std::size_t rule = 0; rule < deduction_rule_names.size(); ++rule) {
+			turns[i].hit_count[rule] += other.turns[i].hit_count[rule];
+			turns[i].fact_count[rule] += other.turns[i].fact_count[rule];
+		}
+	}
+}
+
+Json Statistics::to_json() const {
+	std::size_t determined_game_count = 0;
+	std::size_t total_suggestion_count = 0;
+	for (std::size_t i = 0; i < suggestions_until_determined.size(); ++i) {
+		determined_game_count += suggestions_until_determined[i];
+		total_suggestion_count += i * suggestions_until_determined[i];
+	}
+
+	Json determined {
+		{ "game_count", determined_game_count },
+		{ "mean_suggestions", determined_game_count > 0 ? static_cast<double>(total_suggestion_count) / static_cast<double>(determined_game_count) : 0.0 },
+		{ "suggestions_histogram", suggestions_until_determined },
+	};
+
+	Json turns_json = Json::array();
+	for (std::size_t i = 0; i < turns.size(); ++i) {
+		Json rules = Json::object();
+		for (std::size_t rule = 0; rule < deduction_rule_names.size(); ++rule) {
+			auto game_count_at_turn = static_cast<double>(turns[i].game_count);
+			rules[deduction_rule_names[rule]] = {
+				{ "hit_rate", static_cast<double>(turns[i].hit_count[rule]) / game_count_at_turn },
+				{ "mean_facts", static_cast<double>(turns[i].fact_count[rule]) / game_count_at_turn },
+			};
+		}
+
+		turns_json.push_back({ { "turn", i + 1 }, { "game_count", turns[i].game_count }, { "rules", std::move(rules) } });
+	}
+
+	return {
+		{ "game_count", game_count },
+		{ "invalid_game_count", invalid_game_count },
+		{ "solution_determined", std::move(determined) },
+		{ "turns", std::move(turns_json) },
+	};
+}
+
+static Result<void, std::string> stats(std::string const& corpus_path, std::size_t job_count) {
+	auto maybe_corpus = Cluedo::GameCorpus::open(corpus_path);
+	if (maybe_corpus.is_error())
+		return fmt::format("couldn't open '{}': {}", corpus_path, format_as(maybe_corpus.release_error()));
+
+	auto corpus = maybe_corpus.release_value();
+	auto start_time = std::chrono::steady_clock::now();
+
+	// Each thread takes a contiguous shard of the index, so that it reads the corpus sequentially.
+	auto shard_count = std::max<std::size_t>(1, std::min(job_count, corpus.record_count()));
+	std::vector<Statistics> shard_statistics(shard_count);
+	{
+		std::vector<std::jthread> workers;
+		for (std::size_t shard = 0; shard < shard_count; ++shard) {
+			workers.emplace_back([&corpus, &statistics = shard_statistics[shard], shard, shard_count]() {
+				auto begin = corpus.record_count() * shard / shard_count;
+				auto end = corpus.record_count() * (shard + 1) / shard_count;
+				for (auto i = begin; i < end; ++i) {
+					auto maybe_record = corpus.record(i);
+					if (maybe_record.is_error()) {
+						++statistics.game_count;
+						++statistics.invalid_game_count;
+						continue;
+					}
+
+					statistics.add_game(maybe_record.release_value());
+				}
+			});
+		}
+	}
+
+	Statistics statistics;
+	for (auto const& shard : shard_statistics)
+		statistics.merge(shard);
+
+	fmt::println("{}", statistics.to_json().dump());
+
+	auto elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	fmt::println(stderr, "replayed {} games in {:.3f} s ({:.0f} games/s) with {} threads", statistics.game_count, elapsed_seconds, static_cast<double>(statistics.game_count) / elapsed_seconds, shard_count);
+	return {};
+}
+
+Result<void, std::string> my_main(std::vector<std::string_view>&& arguments) {
+	if (arguments.empty() || ToolUtils::has_option(arguments, "-h"sv, "--help"sv)) {
+		fmt::print("{}", USAGE);
+		return {};
+	}
+
+	auto command = arguments.front();
+	std::size_t job_count = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::string_view> paths;
+	for (std::size_t i = 1; i < arguments.size(); ++i) {
+		auto argument = arguments[i];
+		if (argument == "-j"sv || argument == "--jobs"sv) {
+			if (++i == arguments.size())
+				return fmt::format("missing count after '{}'\n\n{}", argument, USAGE);
+
+			if (!ToolUtils::parse_number(arguments[i], job_count) || job_count == 0)
+				return fmt::format("invalid number of jobs '{}'\n\n{}", arguments[i], USAGE);
+		} else if (argument.starts_with('-')) {
+			return fmt::format("unknown option '{}'\n\n{}", argument, USAGE);
+		} else {
+			paths.push_back(argument);
+		}
+	}
+
+	if (command == "pack"sv) {
+		if (paths.empty())
+			return fmt::format("no corpus given\n\n{}", USAGE);
+
+		return pack(std::string(paths.front()), { paths.begin() + 1, paths.end() });
+	}
+
+	if (command == "stats"sv) {
+		if (paths.size() != 1)
+			return fmt::format("a single corpus must be given\n\n{}", USAGE);
+
+		return stats(std::string(paths.front()), job_count);
+	}
+
+	return fmt::format("unknown command '{}'\n\n{}", command, USAGE);
+}
+
+int main(int argc, char** argv) {
+	return ToolUtils::run_main(argc, argv, my_main);
+}
@@ -0,0 +1,480 @@
+// Serves many headless sessions at once over a Unix domain socket.
+//
+// Usage: cluedo-daemon [options] <socket path>
+//
+// Every connection sends requests as JSON lines, in the format of the
+// headless sessions (see HeadlessSession.hpp), with an extra `session` field
+// that names the session the request is for. A session is created by the
+// first request that names it and is shared by all the connections, so a
+// client can reconnect and continue its game. The responses are written to
+// the connection that sent the request and carry the same `session`.
+//
+// The solves of all the sessions run on a single pool of threads, the
+// sessions that aren't used for a while are evicted, the number of sessions
+// is capped, and the memory used by the game and the number of solves in
+// progress of each session are capped.
+// A session can also be closed with the `close_session` command.
+
+#include "HeadlessSession.hpp"
+#include "SolverPool.hpp"
+#include "ToolUtils.hpp"
+#include "utils/Result.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fmt/core.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std::literals;
+
+using Cluedo::Json;
+using Cluedo::ToolUtils;
+
+static constexpr auto USAGE = R"(Usage: cluedo-daemon [options] <socket path>
+
+Options:
+  -j, --jobs <count>                 Run this many solves at a time, by default as many as the cores.
+  -t, --idle-timeout <seconds>       Evict the sessions that weren't used for this long, by default 1800.
+  -m, --max-session-memory <MiB>     Reject the information that makes a game use more memory than this, by default 64.
+  -s, --max-pending-solves <count>   Reject the solves of a session beyond this many in progress, by default 4.
+  -S, --max-sessions <count>         Reject the new sessions beyond this many open, by default 64.
+  -h, --help                         Show this message.
+)"sv;
+
+// The longest request accepted, a connection that sends a longer one is closed.
+static constexpr std::size_t MAX_REQUEST_LENGTH = 1 << 20;
+
+// The most output kept for a client that doesn't read it, a connection that
+// still has more than this to send when another response comes is closed.
+static constexpr std::size_t MAX_PENDING_OUTPUT_LENGTH = 16 << 20;
+
+struct Options {
+	std::string socket_path;
+	std::size_t job_count { std::max(1u, std::thread::hardware_concurrency()) };
+	std::chrono::seconds idle_timeout { 1800 };
+	std::size_t max_session_memory_usage { 64 << 20 };
+	std::size_t max_pending_solve_count { 4 };
+	std::size_t max_session_count { 64 };
+};
+
+static Result<Options, std::string> parse_arguments(std::vector<std::string_view> const& arguments) {
+	Options options;
+	for (std::size_t i = 0; i < arguments.size(); ++i) {
+		auto argument = arguments[i];
+		if (argument == "-j"sv || argument == "--jobs"sv || argument == "-t"sv || argument == "--idle-timeout"sv || argument == "-m"sv || argument == "--max-session-memory"sv || argument == "-s"sv || argument == "--max-pending-solves"sv || argument == "-S"sv || argument == "--max-sessions"sv) {
+			if (++i == arguments.size())
+				return fmt::format("missing value after '{}'", argument);
+
+			std::size_t count;
+			if (!ToolUtils::parse_number(arguments[i], count) || count == 0)
+				return fmt::format("invalid value '{}' for '{}'", arguments[i], argument);
+
+			if (argument == "-j"sv || argument == "--jobs"sv)
+				options.job_count = count;
+			else if (argument == "-t"sv || argument == "--idle-timeout"sv)
+				options.idle_timeout = std::chrono::seconds(count);
+			else if (argument == "-m"sv || argument == "--max-session-memory"sv)
+				options.max_session_memory_usage = count << 20;
+			else if (argument == "-s"sv || argument == "--max-pending-solves"sv)
+				options.max_pending_solve_count = count;
+			else
+				options.max_session_count = count;
+		} else if (argument.starts_with('-')) {
+			return fmt::format("unknown option '{}'", argument);
+		} else if (options.socket_path.empty()) {
+			options.socket_path = argument;
+		} else {
+			return fmt::format("unexpected argument '{}'", argument);
+		}
+	}
+
+	if (options.socket_path.empty())
+		return "no socket path given"s;
+
+	return options;
+}
+
+static bool set_non_blocking(int fd) {
+	auto flags = fcntl(fd, F_GETFL);
+	return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+}
+
+// A pipe written to by the threads of the pool to wake the event loop up when
+// a response couldn't be sent right away, so that it waits for the socket.
+struct WakePipe {
+	int read_fd;
+	int write_fd;
+};
+
+static Result<WakePipe, std::string> make_wake_pipe() {
+	int fds[2];
+	if (pipe(fds) < 0)
+		return fmt::format("couldn't create the wake pipe: {}", std::strerror(errno));
+
+	// A full pipe already wakes the loop up, so the writes that don't fit are simply dropped.
+	if (!set_non_blocking(fds[0]) || !set_non_blocking(fds[1])) {
+		auto error = fmt::format("couldn't set up the wake pipe: {}", std::strerror(errno));
+		close(fds[0]);
+		close(fds[1]);
+		return error;
+	}
+
+	return WakePipe { fds[0], fds[1] };
+}
+
+// A connection of a client, which is shared with the solves it requested so
+// that its socket is closed only when nothing can write to it anymore.
+//
+// The socket doesn't block: the responses that it doesn't take right away are
+// kept and sent by the event loop as soon as the client reads the previous ones.
+class Connection {
+public:
+	Connection(int fd, int wake_fd)
+	  : m_fd(fd), m_wake_fd(wake_fd) {}
+	~Connection() { close(m_fd); }
+
+	Connection(Connection const&) = delete;
+	Connection& operator=(Connection const&) = delete;
+
+	int fd() const { return m_fd; }
+	std::string& read_buffer() { return m_read_buffer; }
+
+	void write_line(std::string_view line) {
+		std::lock_guard lock(m_write_mutex);
+		if (m_is_broken)
+			return;
+
+		if (m_write_buffer.size() > MAX_PENDING_OUTPUT_LENGTH) {
+			fmt::println(stderr, "closed a connection that didn't read its responses");
+			break_connection();
+			wake();
+			return;
+		}
+
+		m_write_buffer += line;
+		m_write_buffer += '\n';
+		flush_buffer();
+
+		// The event loop closes the connection or sends the rest when the socket can take it.
+		if (m_is_broken || !m_write_buffer.empty())
+			wake();
+	}
+
+	// Sends as much of the pending output as the socket takes.
+	void flush() {
+		std::lock_guard lock(m_write_mutex);
+		flush_buffer();
+	}
+
+	bool has_pending_output() {
+		std::lock_guard lock(m_write_mutex);
+		return !m_write_buffer.empty();
+	}
+
+	bool is_broken() {
+		std::lock_guard lock(m_write_mutex);
+		return m_is_broken;
+	}
+
+private:
+	void flush_buffer() {
+		std::size_t written = 0;
+		while (!m_is_broken && written < m_write_buffer.size()) {
+			auto result = send(m_fd, m_write_buffer.data() + written, m_write_buffer.size() - written, MSG_NOSIGNAL);
+			if (result < 0 && errno == EINTR)
+				continue;
+
+			if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+				break;
+
+			// After a failed write the client is gone, so the rest of the responses are dropped.
+			if (result <= 0)
+				break_connection();
+			else
+				written += static_cast<std::size_t>(result);
+		}
+
+		if (!m_is_broken)
+			m_write_buffer.erase(0, written);
+	}
+
+	// The socket stays open until the solves of the client are over, but the client sees it closed right away.
+	void break_connection() {
+		m_is_broken = true;
+		m_write_buffer = {};
+		shutdown(m_fd, SHUT_RDWR);
+	}
+
+	void wake() {
+		char byte = 0;
+		[[maybe_unused]] auto result = write(m_wake_fd, &byte, 1);
+	}
+
+	int m_fd;
+	int m_wake_fd;
+	std::string m_read_buffer;
+
+	std::mutex m_write_mutex;
+	std::string m_write_buffer;
+	bool m_is_broken { false };
+};
+
+class Daemon {
+public:
+	Daemon(Options const& options, WakePipe wake_pipe)
+	  : m_options(options), m_wake_pipe(wake_pipe), m_solver_pool(options.job_count) {}
+
+	Result<void, std::string> run(int listen_fd);
+
+private:
+	void accept_connection(int listen_fd);
+	// Returns `false` if the connection has to be closed.
+	bool read_requests(std::shared_ptr<Connection> const&);
+	void handle_request(std::shared_ptr<Connection> const&, std::string_view line);
+	void evict_idle_sessions();
+
+	struct Session {
+		std::unique_ptr<Cluedo::HeadlessSession> session;
+		std::chrono::steady_clock::time_point last_use_time;
+	};
+
+	Options const& m_options;
+	WakePipe m_wake_pipe;
+	std::unordered_map<std::string, Session> m_sessions;
+	std::vector<std::shared_ptr<Connection>> m_connections;
+	// The pool is the last member so that it's destroyed first, while the sessions
+	// are still open, so that their clients are told their solves were cancelled.
+	Cluedo::SolverPool m_solver_pool;
+};
+
+static volatile std::sig_atomic_t s_should_stop = 0;
+
+Result<void, std::string> Daemon::run(int listen_fd) {
+	auto last_eviction_time = std::chrono::steady_clock::now();
+	while (!s_should_stop) {
+		std::vector<pollfd> poll_fds { { listen_fd, POLLIN, 0 }, { m_wake_pipe.read_fd, POLLIN, 0 } };
+		for (auto const& connection : m_connections)
+			poll_fds.push_back({ connection->fd(), static_cast<short>(connection->has_pending_output() ? POLLIN | POLLOUT : POLLIN), 0 });
+
+		// The timeout makes sure the idle sessions are evicted even if no request comes.
+		if (poll(poll_fds.data(), poll_fds.size(), 1000) < 0 && errno != EINTR)
+			return fmt::format("couldn't wait for the connections: {}", std::strerror(errno));
+
+		if (poll_fds[1].revents & POLLIN) {
+			char buffer[256];
+			while (read(m_wake_pipe.read_fd, buffer, sizeof(buffer)) > 0) {}
+		}
+
+		// The connections are checked before accepting, since accepting changes their indices.
+		// Every connection is checked, since the threads of the pool can break one at any time.
+		for (std::size_t i = poll_fds.size() - 1; i > 1; --i) {
+			auto const& connection = m_connections[i - 2];
+			auto revents = poll_fds[i].revents;
+			if (revents & POLLOUT)
+				connection->flush();
+
+			auto is_open = (revents & ~POLLOUT) == 0 || read_requests(connection);
+			if (!is_open || connection->is_broken())
+				m_connections.erase(m_connections.begin() + static_cast<std::ptrdiff_t>(i - 2));
+		}
+
+		if (poll_fds[0].revents & POLLIN)
+			accept_connection(listen_fd);
+
+		auto now = std::chrono::steady_clock::now();
+		if (now - last_eviction_time >= std::chrono::seconds(1)) {
+			evict_idle_sessions();
+			last_eviction_time = now;
+		}
+	}
+
+	return {};
+}
+
+void Daemon::accept_connection(int listen_fd) {
+	auto fd = accept(listen_fd, nullptr, nullptr);
+	if (fd < 0) {
+		fmt::println(stderr, "couldn't accept a connection: {}", std::strerror(errno));
+		return;
+	}
+
+	// A client that doesn't read its responses mustn't block the daemon.
+	if (!set_non_blocking(fd)) {
+		fmt::println(stderr, "couldn't set up a connection: {}", std::strerror(errno));
+		close(fd);
+		return;
+	}
+
+	m_connections.push_back(std::make_shared<Connection>(fd, m_wake_pipe.write_fd));
+}
+
+bool Daemon::read_requests(std::shared_ptr<Connection> const& connection) {
+	char buffer[4096];
+	auto result = read(connection->fd(), buffer, sizeof(buffer));
+	if (result < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+		return true;
+
+	if (result <= 0)
+		return false;
+
+	auto& read_buffer = connection->read_buffer();
+	read_buffer.append(buffer, static_cast<std::size_t>(result));
+
+	std::size_t line_start = 0;
+	for (auto line_end = read_buffer.find('\n'); line_end != std::string::npos; line_end = read_buffer.find('\n', line_start)) {
+		handle_request(connection, std::string_view(read_buffer).substr(line_start, line_end - line_start));
+		line_start = line_end + 1;
+	}
+
+	read_buffer.erase(0, line_start);
+	return read_buffer.size() <= MAX_REQUEST_LENGTH;
+}
+
+void Daemon::handle_request(std::shared_ptr<Connection> const& connection, std::string_view line) {
+	if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+		return;
+
+	auto request = Json::parse(line, nullptr, false);
+	if (request.is_discarded() || !request.is_object() || !request.contains("session") || !request["session"].is_string()) {
+		Json response { { "id", request.is_object() && request.contains("id") ? request["id"] : Json() }, { "ok", false }, { "error", format_as(Cluedo::Error::InvalidRequest) } };
+		connection->write_line(response.dump());
+		return;
+	}
+
+	auto const& name = request["session"].get_ref<std::string const&>();
+	if (request.contains("command") && request["command"] == "close_session") {
+		m_sessions.erase(name);
+		Json response { { "id", request.contains("id") ? request["id"] : Json() }, { "ok", true }, { "session", name } };
+		connection->write_line(response.dump());
+		return;
+	}
+
+	// The requests that would open a session beyond the cap are rejected, the client can close one of its sessions or wait for one to be evicted.
+	if (!m_sessions.contains(name) && m_sessions.size() >= m_options.max_session_count) {
+		Json response { { "id", request.contains("id") ? request["id"] : Json() }, { "ok", false }, { "error", format_as(Cluedo::Error::TooManySessions) }, { "session", name } };
+		connection->write_line(response.dump());
+		return;
+	}
+
+	auto [it, is_new] = m_sessions.try_emplace(name);
+	if (is_new)
+		it->second.session = std::make_unique<Cluedo::HeadlessSession>(m_solver_pool, m_options.max_session_memory_usage, m_options.max_pending_solve_count);
+
+	it->second.last_use_time = std::chrono::steady_clock::now();
+	it->second.session->handle_request(request, [connection, name](Json&& response) {
+		response["session"] = name;
+		connection->write_line(response.dump());
+	});
+}
+
+void Daemon::evict_idle_sessions() {
+	auto now = std::chrono::steady_clock::now();
+	std::erase_if(m_sessions, [&](auto const& pair) {
+		auto const& [name, session] = pair;
+		// A session waiting for a solve isn't idle, even if it wasn't used for a while.
+		if (now - session.last_use_time < m_options.idle_timeout || session.session->pending_solve_count() > 0)
+			return false;
+
+		fmt::println(stderr, "evicted idle session '{}'", name);
+		return true;
+	});
+}
+
+static Result<int, std::string> listen_on(std::string const& path) {
+	sockaddr_un address {};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path))
+		return fmt::format("the socket path '{}' is too long", path);
+
+	std::copy(path.begin(), path.end(), address.sun_path);
+
+	auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return fmt::format("couldn't create the socket: {}", std::strerror(errno));
+
+	// A socket left by a daemon that didn't exit cleanly is replaced, while one that still has a daemon listening isn't.
+	if (connect(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == 0) {
+		close(fd);
+		return fmt::format("another daemon is listening on '{}'", path);
+	}
+	unlink(path.c_str());
+
+	// Only the user running the daemon can connect to it.
+	auto old_mask = umask(0177);
+	auto bind_result = bind(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address));
+	umask(old_mask);
+
+	if (bind_result < 0 || listen(fd, SOMAXCONN) < 0) {
+		auto error = fmt::format("couldn't listen on '{}': {}", path, std::strerror(errno));
+		close(fd);
+		return error;
+	}
+
+	return fd;
+}
+
+Result<void, std::string> my_main(std::vector<std::string_view>&& arguments) {
+	if (ToolUtils::has_option(arguments, "-h"sv, "--help"sv)) {
+		fmt::print("{}", USAGE);
+		return {};
+	}
+
+	auto maybe_options = parse_arguments(arguments);
+	if (maybe_options.is_error())
+		return fmt::format("{}\n\n{}", maybe_options.release_error(), USAGE);
+
+	auto options = maybe_options.release_value();
+
+	auto maybe_listen_fd = listen_on(options.socket_path);
+	if (maybe_listen_fd.is_error())
+		return maybe_listen_fd.release_error();
+
+	auto listen_fd = maybe_listen_fd.release_value();
+
+	auto maybe_wake_pipe = make_wake_pipe();
+	if (maybe_wake_pipe.is_error()) {
+		close(listen_fd);
+		unlink(options.socket_path.c_str());
+		return maybe_wake_pipe.release_error();
+	}
+
+	auto wake_pipe = maybe_wake_pipe.release_value();
+
+	struct sigaction action {};
+	action.sa_handler = [](int) { s_should_stop = 1; };
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	// The daemon is destroyed, stopping the solves, before the socket and the pipe are closed.
+	auto result = [&options, listen_fd, wake_pipe]() {
+		Daemon daemon(options, wake_pipe);
+		return daemon.run(listen_fd);
+	}();
+
+	close(wake_pipe.read_fd);
+	close(wake_pipe.write_fd);
+	close(listen_fd);
+	unlink(options.socket_path.c_str());
+	return result;
+}
+
+int main(int argc, char** argv) {
+	return ToolUtils::run_main(argc, argv, my_main);
+}
@@ -1,9 +1,14 @@
 #include "../res/icons/icon.cpp"
+#include "HeadlessSession.hpp"
 #include "fonts/fonts.cpp"
 #include "ui/MainWindow.hpp"
-#include "utils/IconsFontAwesome.h"
 #include "utils/Result.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -20,8 +25,13 @@
 #include <imgui_impl_sdl2.h>
 #include <imgui_stdlib.h>
 
+#include "fonts/icon_ranges.cpp"
+
 using namespace std::literals;
 
+static constexpr std::size_t IDLE_FRAME_COUNT = 3;
+static constexpr int IDLE_WAIT_TIMEOUT_MS = 500;
+
 static void set_window_icon(SDL_Window* window) {
 	std::uint32_t red_mask, green_mask, blue_mask, alpha_mask;
 
@@ -53,9 +63,40 @@ static void set_window_icon(SDL_Window* window) {
 	SDL_FreeSurface(icon_surface);
 }
 
-Result<void, std::string> my_main([[maybe_unused]] std::vector<std::string_view>&& arguments) {
+// Reads the requests of a headless session from the standard input, one per
+// line, and writes the responses to the standard output.
+// On Windows the program is a GUI executable, which starts without a console,
+// so the streams have to be redirected, for instance to pipes.
+static Result<void, std::string> run_headless() {
+	std::ios::sync_with_stdio(false);
+
+	// The responses of the solves are written from the threads of the pool.
+	std::mutex write_mutex;
+	auto respond = [&write_mutex](Cluedo::Json&& response) {
+		auto line = response.dump();
+		std::lock_guard lock(write_mutex);
+		std::fwrite(line.data(), 1, line.size(), stdout);
+		std::fputc('\n', stdout);
+		std::fflush(stdout);
+	};
+
+	Cluedo::SolverPool solver_pool;
+	Cluedo::HeadlessSession session(solver_pool);
+
+	std::string line;
+	while (std::getline(std::cin, line))
+		session.handle_request(line, respond);
+
+	session.wait();
+	return {};
+}
+
+Result<void, std::string> my_main(std::vector<std::string_view>&& arguments) {
 	using namespace std::literals;
 
+	if (std::find(arguments.begin(), arguments.end(), "--headless"sv) != arguments.end())
+		return run_headless();
+
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0) {
 		return { SDL_GetError() };
 	}
@@ -127,11 +168,13 @@ Result<void, std::string> my_main([[maybe_unused]] std::vector<std::string_view>
 	ImGui::GetIO().LogFilename = nullptr;
 	{
 		float base_font_size = 20.0f;
+		// The atlas only grows as much as it's needed, instead of up to the next power of two.
+		ImGui::GetIO().Fonts->Flags |= ImFontAtlasFlags_NoPowerOfTwoHeight;
 		ImGui::GetIO().Fonts->AddFontFromMemoryCompressedTTF(ibm_plex_sans_regular_compressed_data, ibm_plex_sans_regular_compressed_size, base_font_size);
 		ImFontConfig config;
 		config.MergeMode = true;
 		config.GlyphMinAdvanceX = base_font_size * 2.0f / 3.0f;
-		static ImWchar const icon_ranges[] = { ICON_MIN_FA, ICON_MAX_FA, 0 };
+		// The ranges contain only the icons used by the UI, they are generated at build time.
 		ImGui::GetIO().Fonts->AddFontFromMemoryCompressedTTF(fa_regular_compressed_data, fa_regular_compressed_size, base_font_size * 2.0 / 3.0f, &config, icon_ranges);
 		ImGui::GetIO().Fonts->AddFontFromMemoryCompressedTTF(fa_solid_compressed_data, fa_solid_compressed_size, base_font_size * 2.0 / 3.0f, &config, icon_ranges);
 	}
@@ -141,39 +184,64 @@ Result<void, std::string> my_main([[maybe_unused]] std::vector<std::string_view>
 	ImGui_ImplSDL2_InitForOpenGL(window, gl_context);
 	ImGui_ImplOpenGL3_Init(glsl_version);
 
-	bool running = true;
-	Cluedo::UI::MainWindow main_window;
+	// The background solver pushes this event to wake up the loop when it finds the solutions.
+	std::uint32_t solutions_found_event_type = SDL_RegisterEvents(1);
+	if (solutions_found_event_type == static_cast<std::uint32_t>(-1)) {
+		return { SDL_GetError() };
+	}
 
-	while (running) {
-		SDL_Event event;
-		while (SDL_PollEvent(&event)) {
-			ImGui_ImplSDL2_ProcessEvent(&event);
-			if (event.type == SDL_QUIT) {
-				running = false;
+	// The window is destroyed before SDL is shut down, so that its solver can't push events anymore.
+	{
+		bool running = true;
+		// A few frames are drawn after the last event, since ImGui needs them to settle after a change.
+		std::size_t frames_since_last_event = 0;
+		Cluedo::UI::MainWindow main_window([solutions_found_event_type]() {
+			SDL_Event event {};
+			event.type = solutions_found_event_type;
+			SDL_PushEvent(&event);
+		});
+
+		while (running) {
+			// When nothing changes the loop waits for the next event instead of drawing the same frame again.
+			bool is_idle = frames_since_last_event >= IDLE_FRAME_COUNT && !main_window.is_computing_solutions() && !ImGui::GetIO().WantTextInput;
+			bool is_minimized = SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED;
+
+			SDL_Event event;
+			bool has_event = is_idle || is_minimized ? SDL_WaitEventTimeout(&event, IDLE_WAIT_TIMEOUT_MS) : SDL_PollEvent(&event);
+			while (has_event) {
+				frames_since_last_event = 0;
+
+				ImGui_ImplSDL2_ProcessEvent(&event);
+				if (event.type == SDL_QUIT) {
+					running = false;
+				}
+
+				if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window)) {
+					running = false;
+				}
+
+				has_event = SDL_PollEvent(&event);
 			}
 
-			if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window)) {
-				running = false;
+			if (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) {
+				continue;
 			}
-		}
 
-		if (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) {
-			SDL_Delay(10);
-			continue;
-		}
+			++frames_since_last_event;
 
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplSDL2_NewFrame();
-		ImGui::NewFrame();
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplSDL2_NewFrame();
+			ImGui::NewFrame();
 
-		main_window.show();
+			main_window.show();
 
-		ImGui::Render();
-		glViewport(0, 0, (int)ImGui::GetIO().DisplaySize.x, (int)ImGui::GetIO().DisplaySize.y);
-		glClearColor(0, 0, 0, 1);
-		glClear(GL_COLOR_BUFFER_BIT);
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-		SDL_GL_SwapWindow(window);
+			ImGui::Render();
+			glViewport(0, 0, (int)ImGui::GetIO().DisplaySize.x, (int)ImGui::GetIO().DisplaySize.y);
+			glClearColor(0, 0, 0, 1);
+			glClear(GL_COLOR_BUFFER_BIT);
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			SDL_GL_SwapWindow(window);
+		}
 	}
 
 	ImGui_ImplOpenGL3_Shutdown();
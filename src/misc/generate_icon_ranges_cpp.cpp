@@ -0,0 +1,94 @@
+// Generates the glyph ranges of the icons used by the application.
+//
+// Usage: generate_icon_ranges_cpp <output file> <icons header> <source files...>
+//
+// The source files are searched for the names of the icons defined in the
+// icons header (e.g. `ICON_FA_TRIANGLE_EXCLAMATION`) and the output file gets
+// the `icon_ranges` array, which can be passed to Dear ImGui so that only the
+// glyphs of those icons are rasterized into the font atlas, instead of the
+// whole FontAwesome range.
+
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+
+static bool read_file(std::string const& path, std::string& content) {
+	std::ifstream file(path);
+	if (!file) {
+		fmt::println(stderr, "error: couldn't open '{}'", path);
+		return false;
+	}
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	content = stream.str();
+	return true;
+}
+
+static bool write_file(std::string const& path, std::string const& content) {
+	std::ofstream file(path);
+	if (!(file << content)) {
+		fmt::println(stderr, "error: couldn't write '{}'", path);
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		fmt::println(stderr, "usage: {} <output file> <icons header> <source files...>", argv[0]);
+		return 1;
+	}
+
+	std::string icons_header;
+	if (!read_file(argv[2], icons_header))
+		return 1;
+
+	// The header defines every icon as `#define ICON_FA_NAME "<UTF-8>" // U+<codepoint>`.
+	std::map<std::string, unsigned long> codepoints;
+	std::regex const icon_definition_regex(R"(#define (ICON_FA_\w+) +"[^"]*" +// U\+([0-9a-fA-F]+))");
+	for (auto it = std::sregex_iterator(icons_header.begin(), icons_header.end(), icon_definition_regex); it != std::sregex_iterator(); ++it)
+		codepoints.emplace((*it)[1].str(), std::stoul((*it)[2].str(), nullptr, 16));
+
+	if (codepoints.empty()) {
+		fmt::println(stderr, "error: no icons found in '{}'", argv[2]);
+		return 1;
+	}
+
+	// The icons are ordered by codepoint, since Dear ImGui wants the ranges in ascending order.
+	std::map<unsigned long, std::string> used_icons;
+	std::regex const icon_use_regex(R"(\bICON_FA_\w+)");
+	for (int i = 3; i < argc; ++i) {
+		std::string source;
+		if (!read_file(argv[i], source))
+			return 1;
+
+		for (auto it = std::sregex_iterator(source.begin(), source.end(), icon_use_regex); it != std::sregex_iterator(); ++it) {
+			auto name = it->str();
+			auto codepoint_it = codepoints.find(name);
+			if (codepoint_it == codepoints.end()) {
+				fmt::println(stderr, "error: unknown icon '{}' used in '{}'", name, argv[i]);
+				return 1;
+			}
+
+			used_icons.emplace(codepoint_it->second, std::move(name));
+		}
+	}
+
+	std::string source;
+	auto source_inserter = std::back_inserter(source);
+	fmt::format_to(source_inserter, "static ImWchar const icon_ranges[] = {{\n");
+	for (auto const& [codepoint, name] : used_icons)
+		fmt::format_to(source_inserter, "\t0x{:x}, 0x{:x}, // {}\n", codepoint, codepoint, name);
+	fmt::format_to(source_inserter, "\t0,\n}};\n");
+
+	if (!write_file(argv[1], source))
+		return 1;
+
+	return 0;
+}
@@ -1,21 +1,179 @@
-#include <stdio.h>
+// Compiles the language files into constant string tables.
+//
+// Usage: generate_langs_cpp <output directory> <languages directory> <language ids...> <language names...>
+//
+// The keys of the strings are taken from the first language and every other
+// language must have exactly the same keys, otherwise the generation fails.
+// Two files are written in the output directory:
+// * langs.hpp: the enum of the keys of the strings and the table of their names;
+// * langs.cpp: the table of the strings of each language and the list of languages.
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+using json = nlohmann::ordered_json;
+
+struct Language {
+	std::string id;
+	std::string name;
+	std::vector<std::pair<std::string, std::string>> strings;
+};
+
+static bool flatten_strings(json const& object, std::string const& key_prefix, Language& language) {
+	for (auto const& [key, value] : object.items()) {
+		auto full_key = key_prefix.empty() ? key : fmt::format("{}.{}", key_prefix, key);
+		if (value.is_object()) {
+			if (!flatten_strings(value, full_key, language))
+				return false;
+		} else if (value.is_string()) {
+			language.strings.emplace_back(std::move(full_key), value.get<std::string>());
+		} else {
+			fmt::println(stderr, "error: the value of '{}' in language '{}' isn't a string", full_key, language.id);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool write_file(std::string const& path, std::string const& content) {
+	std::ofstream file(path);
+	if (!(file << content)) {
+		fmt::println(stderr, "error: couldn't write '{}'", path);
+		return false;
+	}
+
+	return true;
+}
+
+static std::string key_identifier(std::string const& key) {
+	std::string identifier = key;
+	for (auto& c : identifier) {
+		if (c == '.')
+			c = '_';
+	}
+
+	return identifier;
+}
+
+static std::string string_literal(std::string const& string) {
+	std::string literal = "\"";
+	for (unsigned char c : string) {
+		if (c == '"' || c == '\\')
+			literal += fmt::format("\\{}", static_cast<char>(c));
+		else if (c == '\n')
+			literal += "\\n";
+		else if (c < 0x20 || c >= 0x7f)
+			literal += fmt::format("\\{:03o}", c);
+		else
+			literal += static_cast<char>(c);
+	}
+
+	return literal + "\"";
+}
 
 int main(int argc, char** argv) {
-	++argv;
-	--argc;
+	if (argc < 5 || (argc - 3) % 2 != 0) {
+		fmt::println(stderr, "usage: {} <output directory> <languages directory> <language ids...> <language names...>", argv[0]);
+		return 1;
+	}
 
-	int language_count = argc / 2;
+	std::string output_directory = argv[1];
+	std::string languages_directory = argv[2];
+	int language_count = (argc - 3) / 2;
+
+	std::vector<Language> languages;
 	for (int i = 0; i < language_count; ++i) {
-		printf("#include \"%s.cpp\"\n", argv[i]);
+		Language language { argv[3 + i], argv[3 + language_count + i], {} };
+
+		auto path = fmt::format("{}/{}.json", languages_directory, language.id);
+		std::ifstream file(path);
+		if (!file) {
+			fmt::println(stderr, "error: couldn't open '{}'", path);
+			return 1;
+		}
+
+		try {
+			auto object = json::parse(file);
+			if (!object.is_object() || !flatten_strings(object, "", language))
+				return 1;
+		} catch (json::exception const& exception) {
+			fmt::println(stderr, "error: couldn't parse '{}': {}", path, exception.what());
+			return 1;
+		}
+
+		languages.push_back(std::move(language));
 	}
 
-	printf("#define _ENUMERATE_LANGUAGES \\\n");
-	for (int i = 0; i < language_count; ++i) {
-		printf("_ENUMERATE_LANGUAGE(%s, %s)", argv[i], argv[i + language_count]);
-		if (i < language_count - 1)
-			printf(" \\\n");
+	// Every language must have the same keys of the first one, in any order.
+	auto const& keys = languages.front().strings;
+	bool are_keys_valid = true;
+	for (auto const& language : languages) {
+		std::set<std::string> language_keys;
+		for (auto const& [key, string] : language.strings) {
+			if (!language_keys.insert(key).second) {
+				fmt::println(stderr, "error: key '{}' is defined more than once in language '{}'", key, language.id);
+				are_keys_valid = false;
+			}
+		}
+
+		for (auto const& [key, string] : keys) {
+			if (!language_keys.erase(key)) {
+				fmt::println(stderr, "error: key '{}' is missing in language '{}'", key, language.id);
+				are_keys_valid = false;
+			}
+		}
+
+		for (auto const& key : language_keys) {
+			fmt::println(stderr, "error: key '{}' of language '{}' is missing in language '{}'", key, language.id, languages.front().id);
+			are_keys_valid = false;
+		}
+	}
+
+	if (!are_keys_valid)
+		return 1;
+
+	std::string header;
+	auto header_inserter = std::back_inserter(header);
+	fmt::format_to(header_inserter, "#pragma once\n\n#include <array>\n#include <cstdint>\n#include <string_view>\n\nnamespace Cluedo {{\n\n");
+	fmt::format_to(header_inserter, "enum class StringKey : std::uint16_t {{\n");
+	for (auto const& [key, string] : keys)
+		fmt::format_to(header_inserter, "\t{},\n", key_identifier(key));
+	fmt::format_to(header_inserter, "}};\n\n");
+	fmt::format_to(header_inserter, "constexpr std::size_t STRING_KEY_COUNT = {};\n\n", keys.size());
+	fmt::format_to(header_inserter, "constexpr std::array<std::string_view, STRING_KEY_COUNT> string_key_names {{\n");
+	for (auto const& [key, string] : keys)
+		fmt::format_to(header_inserter, "\t{},\n", string_literal(key));
+	fmt::format_to(header_inserter, "}};\n\n}}\n");
+
+	std::string source;
+	auto source_inserter = std::back_inserter(source);
+	fmt::format_to(source_inserter, "#include \"langs.hpp\"\n\n");
+	for (auto const& language : languages) {
+		std::vector<std::string const*> strings(keys.size());
+		for (auto const& [key, string] : language.strings) {
+			auto it = std::find_if(keys.begin(), keys.end(), [&key](auto const& pair) { return pair.first == key; });
+			strings.at(static_cast<std::size_t>(it - keys.begin())) = &string;
+		}
+
+		fmt::format_to(source_inserter, "static constexpr std::array<std::string_view, Cluedo::STRING_KEY_COUNT> lang_{}_strings {{\n", language.id);
+		for (auto const* string : strings)
+			fmt::format_to(source_inserter, "\t{},\n", string_literal(*string));
+		fmt::format_to(source_inserter, "}};\n\n");
 	}
-	printf("\n");
+
+	fmt::format_to(source_inserter, "#define _ENUMERATE_LANGUAGES \\\n");
+	for (int i = 0; i < language_count; ++i)
+		fmt::format_to(source_inserter, "_ENUMERATE_LANGUAGE({}, {}){}\n", languages.at(i).id, languages.at(i).name, i < language_count - 1 ? " \\" : "");
+
+	if (!write_file(fmt::format("{}/langs.hpp", output_directory), header) || !write_file(fmt::format("{}/langs.cpp", output_directory), source))
+		return 1;
 
 	return 0;
 }
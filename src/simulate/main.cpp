@@ -0,0 +1,296 @@
+// Simulates games between solvers, to generate realistic games with a known deal.
+//
+// Usage: cluedo-simulate [options]
+//
+// Every game deals random hands and lets the players make suggestions and
+// respond to them by the policies given (see Strategy.hpp), while each of
+// them feeds what they see to their own solver and accuses once it knows the
+// solution. The games are simulated in
+// parallel, but each one only depends on the seed and its index, so the same
+// options always give the same games, whatever the number of threads.
+//
+// A summary of the games is written as JSON, while the games themselves,
+// with their deal, can be written as JSON lines and their records, as seen
+// by the first player, into a corpus (see GameCorpus.hpp).
+
+#include "GameCorpus.hpp"
+#include "JsonUtils.hpp"
+#include "Simulator.hpp"
+#include "ToolUtils.hpp"
+#include "utils/Result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fmt/core.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+using Cluedo::Json;
+using Cluedo::ToolUtils;
+
+static constexpr auto USAGE = R"(Usage: cluedo-simulate [options]
+
+Options:
+  -n, --games <count>            Simulate this many games, by default 1000.
+  -p, --players <count>          The number of players, from 2 to 6, by default 4.
+  -s, --seed <seed>              The seed of the games, by default 1.
+  -S, --suggestions <policy>     How the players choose their suggestions: 'unknown' (default) or 'random'.
+  -r, --responses <policy>       Which card the players show: 'random' (default), 'first' or 'repeat'.
+  -m, --max-suggestions <count>  Abandon a game after this many suggestions, by default 200.
+  -o, --output <file>            Write every game, with its deal, as a JSON line.
+  -c, --corpus <file>            Write the record of every game, as seen by the first player, into a corpus.
+  -j, --jobs <count>             Simulate this many games at a time, by default as many as the cores.
+  -h, --help                     Show this message.
+)"sv;
+
+struct Options {
+	std::size_t game_count { 1000 };
+	std::uint64_t seed { 1 };
+	std::size_t player_count { 4 };
+	Cluedo::SuggestionPolicy suggestion_policy { Cluedo::SuggestionPolicy::Unknown };
+	Cluedo::ResponsePolicy response_policy { Cluedo::ResponsePolicy::Random };
+	Cluedo::SimulationOptions simulation;
+	std::optional<std::string> output_path;
+	std::optional<std::string> corpus_path;
+	std::size_t job_count { std::max(1u, std::thread::hardware_concurrency()) };
+};
+
+static Result<Options, std::string> parse_arguments(std::vector<std::string_view> const& arguments) {
+	Options options;
+	for (std::size_t i = 0; i < arguments.size(); ++i) {
+		auto argument = arguments[i];
+		if (!argument.starts_with('-'))
+			return fmt::format("unexpected argument '{}'", argument);
+
+		// Every option takes a value.
+		if (i + 1 == arguments.size())
+			return fmt::format("missing value after '{}'", argument);
+
+		auto value = arguments[++i];
+		if (argument == "-n"sv || argument == "--games"sv) {
+			if (!ToolUtils::parse_number(value, options.game_count))
+				return fmt::format("invalid number of games '{}'", value);
+		} else if (argument == "-p"sv || argument == "--players"sv) {
+			if (!ToolUtils::parse_number(value, options.player_count) || options.player_count < Cluedo::Solver::MIN_PLAYER_COUNT || options.player_count > Cluedo::Solver::MAX_PLAYER_COUNT)
+				return fmt::format("invalid number of players '{}'", value);
+		} else if (argument == "-s"sv || argument == "--seed"sv) {
+			if (!ToolUtils::parse_number(value, options.seed))
+				return fmt::format("invalid seed '{}'", value);
+		} else if (argument == "-S"sv || argument == "--suggestions"sv) {
+			if (value == "unknown"sv)
+				options.suggestion_policy = Cluedo::SuggestionPolicy::Unknown;
+			else if (value == "random"sv)
+				options.suggestion_policy = Cluedo::SuggestionPolicy::Random;
+			else
+				return fmt::format("unknown suggestion policy '{}'", value);
+		} else if (argument == "-r"sv || argument == "--responses"sv) {
+			if (value == "random"sv)
+				options.response_policy = Cluedo::ResponsePolicy::Random;
+			else if (value == "first"sv)
+				options.response_policy = Cluedo::ResponsePolicy::First;
+			else if (value == "repeat"sv)
+				options.response_policy = Cluedo::ResponsePolicy::Repeat;
+			else
+				return fmt::format("unknown response policy '{}'", value);
+		} else if (argument == "-m"sv || argument == "--max-suggestions"sv) {
+			if (!ToolUtils::parse_number(value, options.simulation.max_suggestion_count))
+				return fmt::format("invalid number of suggestions '{}'", value);
+		} else if (argument == "-o"sv || argument == "--output"sv) {
+			options.output_path = value;
+		} else if (argument == "-c"sv || argument == "--corpus"sv) {
+			options.corpus_path = value;
+		} else if (argument == "-j"sv || argument == "--jobs"sv) {
+			if (!ToolUtils::parse_number(value, options.job_count) || options.job_count == 0)
+				return fmt::format("invalid number of jobs '{}'", value);
+		} else {
+			return fmt::format("unknown option '{}'", argument);
+		}
+	}
+
+	return options;
+}
+
+static Json game_to_json(std::size_t game_index, Cluedo::SimulatedGame const& game) {
+	Json hands = Json::array();
+	for (auto const& hand : game.deal.hands) {
+		Json cards = Json::array();
+		for (auto card : hand)
+			cards.push_back(format_as(card));
+
+		hands.push_back(std::move(cards));
+	}
+
+	Json suggestions = Json::array();
+	for (auto const& suggestion : game.suggestions)
+		suggestions.push_back(Cluedo::JsonUtils::information_to_json(suggestion));
+
+	return {
+		{ "game", game_index },
+		{ "solution", { format_as(game.deal.solution[0]), format_as(game.deal.solution[1]), format_as(game.deal.solution[2]) } },
+		{ "hands", std::move(hands) },
+		{ "suggestions", std::move(suggestions) },
+		{ "winner", game.winner_index ? Json(*game.winner_index) : Json(nullptr) },
+		{ "eliminated", game.eliminated_player_indices },
+		{ "is_consistent", game.is_consistent },
+	};
+}
+
+// The summary of some games, which is kept by each thread and then merged.
+struct Summary {
+	std::size_t game_count { 0 };
+	std::size_t inconsistent_game_count { 0 };
+	std::size_t suggestion_count { 0 };
+	std::vector<std::size_t> win_counts; // The games won by each player.
+	std::size_t won_game_suggestion_count { 0 };
+
+	void add_game(Cluedo::SimulatedGame const& game) {
+		++game_count;
+		inconsistent_game_count += !game.is_consistent;
+		suggestion_count += game.suggestions.size();
+		if (game.winner_index) {
+			++win_counts[*game.winner_index];
+			won_game_suggestion_count += game.suggestions.size();
+		}
+	}
+
+	void merge(Summary const& other) {
+		game_count += other.game_count;
+		inconsistent_game_count += other.inconsistent_game_count;
+		suggestion_count += other.suggestion_count;
+		for (std::size_t i = 0; i < win_counts.size(); ++i)
+			win_counts[i] += other.win_counts[i];
+		won_game_suggestion_count += other.won_game_suggestion_count;
+	}
+
+	Json to_json() const {
+		std::size_t won_game_count = 0;
+		for (auto count : win_counts)
+			won_game_count += count;
+
+		return {
+			{ "game_count", game_count },
+			{ "won_game_count", won_game_count },
+			{ "abandoned_game_count", game_count - won_game_count },
+			{ "inconsistent_game_count", inconsistent_game_count },
+			{ "mean_suggestions", game_count > 0 ? static_cast<double>(suggestion_count) / static_cast<double>(game_count) : 0.0 },
+			{ "mean_suggestions_to_win", won_game_count > 0 ? static_cast<double>(won_game_suggestion_count) / static_cast<double>(won_game_count) : 0.0 },
+			{ "wins_by_player", win_counts },
+		};
+	}
+};
+
+// What is written for a game, which is prepared by the thread that simulated it.
+struct GameOutput {
+	std::string line;
+	std::string binary_record;
+};
+
+Result<void, std::string> my_main(std::vector<std::string_view>&& arguments) {
+	if (ToolUtils::has_option(arguments, "-h"sv, "--help"sv)) {
+		fmt::print("{}", USAGE);
+		return {};
+	}
+
+	auto maybe_options = parse_arguments(arguments);
+	if (maybe_options.is_error())
+		return fmt::format("{}\n\n{}", maybe_options.release_error(), USAGE);
+
+	auto options = maybe_options.release_value();
+
+	std::FILE* output_file = nullptr;
+	if (options.output_path) {
+		output_file = std::fopen(options.output_path->c_str(), "w");
+		if (output_file == nullptr)
+			return fmt::format("couldn't open '{}' for writing", *options.output_path);
+	}
+
+	std::optional<Cluedo::GameCorpusWriter> corpus_writer;
+	if (options.corpus_path) {
+		auto maybe_corpus_writer = Cluedo::GameCorpusWriter::create(*options.corpus_path);
+		if (maybe_corpus_writer.is_error())
+			return fmt::format("couldn't create '{}'", *options.corpus_path);
+
+		corpus_writer.emplace(maybe_corpus_writer.release_value());
+	}
+
+	auto start_time = std::chrono::steady_clock::now();
+
+	// The games are written in the order of their index, as soon as it's possible.
+	bool has_corpus_error = false;
+	ToolUtils::OrderedWriter<GameOutput> writer([&](GameOutput& output) {
+		if (output_file != nullptr)
+			std::fputs(output.line.c_str(), output_file);
+
+		if (corpus_writer && corpus_writer->append(output.binary_record).is_error())
+			has_corpus_error = true;
+	});
+	bool is_writing = output_file != nullptr || corpus_writer;
+	std::atomic<std::size_t> next_game_index { 0 };
+	auto thread_count = std::max<std::size_t>(1, std::min(options.job_count, options.game_count));
+	std::vector<Summary> thread_summaries(thread_count, Summary { .win_counts = std::vector<std::size_t>(options.player_count) });
+	{
+		std::vector<std::jthread> workers;
+		for (std::size_t thread = 0; thread < thread_count; ++thread) {
+			workers.emplace_back([&, &summary = thread_summaries[thread]]() {
+				// Every player has the same policies, but each one needs its own strategy.
+				std::vector<std::unique_ptr<Cluedo::Strategy>> strategies;
+				std::vector<Cluedo::Strategy*> players;
+				for (std::size_t i = 0; i < options.player_count; ++i)
+					players.push_back(strategies.emplace_back(std::make_unique<Cluedo::SolverStrategy>("policies", options.suggestion_policy, options.response_policy)).get());
+
+				for (auto begin = next_game_index.fetch_add(ToolUtils::GAMES_PER_BATCH); begin < options.game_count; begin = next_game_index.fetch_add(ToolUtils::GAMES_PER_BATCH)) {
+					for (auto index = begin; index < std::min(begin + ToolUtils::GAMES_PER_BATCH, options.game_count); ++index) {
+						auto game = Cluedo::simulate_game(players, options.simulation, options.seed, index);
+						summary.add_game(game);
+						if (!is_writing)
+							continue;
+
+						GameOutput output;
+						if (output_file != nullptr)
+							output.line = game_to_json(index, game).dump() + '\n';
+
+						if (corpus_writer) {
+							// The records of simulated games can always be converted, since their suggestions are well formed.
+							output.binary_record = game.record_for_player(0).to_binary().release_value();
+						}
+
+						writer.write(index, std::move(output));
+					}
+				}
+			});
+		}
+	}
+
+	Summary summary { .win_counts = std::vector<std::size_t>(options.player_count) };
+	for (auto const& thread_summary : thread_summaries)
+		summary.merge(thread_summary);
+
+	fmt::println("{}", summary.to_json().dump());
+
+	auto elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	fmt::println(stderr, "simulated {} games in {:.3f} s ({:.0f} games/s) with {} threads", summary.game_count, elapsed_seconds, static_cast<double>(summary.game_count) / elapsed_seconds, thread_count);
+
+	if (output_file != nullptr && std::fclose(output_file) != 0)
+		return fmt::format("couldn't write '{}'", *options.output_path);
+
+	if (corpus_writer && (has_corpus_error || corpus_writer->finish().is_error()))
+		return fmt::format("couldn't write '{}'", *options.corpus_path);
+
+	// A solver that contradicts the deal has a bug, so the games that show it have to be looked at.
+	if (summary.inconsistent_game_count > 0)
+		return fmt::format("{} of {} games were contradicted by a solver", summary.inconsistent_game_count, summary.game_count);
+
+	return {};
+}
+
+int main(int argc, char** argv) {
+	return ToolUtils::run_main(argc, argv, my_main);
+}
@@ -0,0 +1,63 @@
+// Tests that the C interface rejects the information that can't happen in a game.
+
+#include "Test.hpp"
+#include "cluedo.h"
+
+static constexpr cluedo_suggestion VALID_SUGGESTION { 0, CLUEDO_CARD_PLUM, CLUEDO_CARD_ROPE, CLUEDO_CARD_HALL, 1, CLUEDO_CARD_ROPE };
+
+static cluedo_solver* create_solver() {
+	cluedo_player_data players[] { { "A", 6 }, { "B", 6 }, { "C", 6 } };
+	cluedo_solver* solver = nullptr;
+	CHECK(cluedo_solver_create(players, 3, &solver) == CLUEDO_OK);
+	return solver;
+}
+
+// Checks that the suggestion is rejected up front and that the game can still be serialized.
+static void check_rejected(cluedo_suggestion const& suggestion) {
+	auto* solver = create_solver();
+	CHECK(cluedo_solver_learn_from_suggestion(solver, &suggestion) == CLUEDO_ERROR_INVALID_ARGUMENT);
+	CHECK(cluedo_solver_information_count(solver) == 0);
+
+	size_t size = 0;
+	char buffer[256];
+	CHECK(cluedo_solver_serialize_binary(solver, buffer, sizeof(buffer), &size) == CLUEDO_OK);
+	cluedo_solver_destroy(solver);
+}
+
+static void test_valid_suggestion() {
+	auto* solver = create_solver();
+	CHECK(cluedo_solver_learn_from_suggestion(solver, &VALID_SUGGESTION) == CLUEDO_OK);
+	CHECK(cluedo_solver_information_count(solver) == 1);
+	cluedo_solver_destroy(solver);
+}
+
+static void test_cards_of_the_wrong_category() {
+	auto suggestion = VALID_SUGGESTION;
+	suggestion.suspect = CLUEDO_CARD_ROPE;
+	suggestion.weapon = CLUEDO_CARD_PLUM;
+	check_rejected(suggestion);
+
+	suggestion = VALID_SUGGESTION;
+	suggestion.room = CLUEDO_CARD_KNIFE;
+	check_rejected(suggestion);
+}
+
+static void test_response_card_not_suggested() {
+	auto suggestion = VALID_SUGGESTION;
+	suggestion.response_card = CLUEDO_CARD_KNIFE;
+	check_rejected(suggestion);
+}
+
+static void test_player_responding_to_themselves() {
+	auto suggestion = VALID_SUGGESTION;
+	suggestion.responding_player_index = suggestion.suggesting_player_index;
+	check_rejected(suggestion);
+}
+
+int main() {
+	test_valid_suggestion();
+	test_cards_of_the_wrong_category();
+	test_response_card_not_suggested();
+	test_player_responding_to_themselves();
+	return Cluedo::Tests::exit_code();
+}
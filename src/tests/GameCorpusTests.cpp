@@ -0,0 +1,126 @@
+// Tests the corpora of game records (CLGC) and their rejection when malformed.
+
+#include "GameCorpus.hpp"
+#include "Test.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using Cluedo::Card;
+using Cluedo::Error;
+using Cluedo::GameCorpus;
+using Cluedo::Solver;
+
+static constexpr std::size_t RECORD_COUNT = 3;
+
+static std::string const& corpus_path() {
+	static auto const path = (std::filesystem::temp_directory_path() / "cluedo-game-corpus-tests.clgc").string();
+	return path;
+}
+
+static std::string read_file(std::string const& path) {
+	std::ifstream file(path, std::ios::binary);
+	return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+static void write_file(std::string const& path, std::string_view data) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+// Writes a valid corpus and returns its content.
+static std::string write_corpus() {
+	auto writer = Cluedo::GameCorpusWriter::create(corpus_path()).release_value();
+	for (std::size_t i = 0; i < RECORD_COUNT; ++i) {
+		Cluedo::GameRecord record { { { "A", 9 }, { "B", 9 } }, {} };
+		for (std::size_t j = 0; j <= i; ++j)
+			record.informations.push_back(Solver::Suggestion { j % 2, Card::Plum, Card::Rope, Card::Hall, (j + 1) % 2, Card::Rope });
+
+		CHECK(writer.append(record.to_binary().release_value()).is_value());
+	}
+
+	CHECK(writer.finish().is_value());
+	return read_file(corpus_path());
+}
+
+// Checks that the corpus with this content is rejected, either when it's opened or when any of its records is read.
+static bool is_rejected(std::string_view data) {
+	write_file(corpus_path(), data);
+	auto maybe_corpus = GameCorpus::open(corpus_path());
+	if (maybe_corpus.is_error())
+		return true;
+
+	auto corpus = maybe_corpus.release_value();
+	for (std::size_t i = 0; i < corpus.record_count(); ++i) {
+		if (corpus.record(i).is_error())
+			return true;
+	}
+
+	return false;
+}
+
+static void test_valid_corpus() {
+	write_corpus();
+	auto maybe_corpus = GameCorpus::open(corpus_path());
+	CHECK(maybe_corpus.is_value());
+	if (maybe_corpus.is_error())
+		return;
+
+	auto corpus = maybe_corpus.release_value();
+	CHECK(corpus.record_count() == RECORD_COUNT);
+	for (std::size_t i = 0; i < RECORD_COUNT; ++i) {
+		auto record = corpus.record(i);
+		CHECK(record.is_value() && record.release_value().information_count() == i + 1);
+	}
+
+	CHECK(corpus.record(RECORD_COUNT).is_error());
+}
+
+static void test_missing_file() {
+	std::filesystem::remove(corpus_path());
+	auto maybe_corpus = GameCorpus::open(corpus_path());
+	CHECK(maybe_corpus.is_error() && maybe_corpus.release_error() == Error::CouldNotOpenFile);
+}
+
+static void test_truncated_corpus() {
+	auto data = write_corpus();
+	for (std::size_t size = 0; size < data.size(); ++size)
+		CHECK(is_rejected(std::string_view(data).substr(0, size)));
+
+	CHECK(is_rejected(data + '\0'));
+}
+
+static void test_corrupted_corpus() {
+	auto data = write_corpus();
+	auto corrupted = [&data](std::size_t offset, char byte) {
+		auto copy = data;
+		copy[offset] = byte;
+		return copy;
+	};
+
+	CHECK(is_rejected(corrupted(0, 'X'))); // The magic.
+	CHECK(is_rejected(corrupted(4, 2)));   // The version.
+	CHECK(is_rejected(corrupted(8, 4)));   // The number of records.
+	CHECK(is_rejected(corrupted(15, 1)));
+	CHECK(is_rejected(corrupted(16, 0))); // The offset of the index.
+	CHECK(is_rejected(corrupted(23, 1)));
+
+	// The magic of the first record, right after the header.
+	CHECK(is_rejected(corrupted(24, 'X')));
+
+	// The last entry of the index, pointing into the header or past the records.
+	auto last_entry = data.size() - 12;
+	CHECK(is_rejected(corrupted(last_entry, 0)));
+	CHECK(is_rejected(corrupted(last_entry + 7, 1)));
+	// The size of the last record.
+	CHECK(is_rejected(corrupted(last_entry + 8, '\xff')));
+}
+
+int main() {
+	test_valid_corpus();
+	test_missing_file();
+	test_truncated_corpus();
+	test_corrupted_corpus();
+	std::filesystem::remove(corpus_path());
+	return Cluedo::Tests::exit_code();
+}
@@ -0,0 +1,122 @@
+// Tests the edits of the information of a game log, around its snapshots.
+
+#include "GameLog.hpp"
+#include "Simulator.hpp"
+#include "Test.hpp"
+
+#include <memory>
+
+using Cluedo::GameLog;
+using Cluedo::Solver;
+
+static constexpr std::size_t SNAPSHOT_INTERVAL = GameLog::SNAPSHOT_INTERVAL;
+
+// A game long enough to span a few snapshots, as seen by the first player.
+static Cluedo::GameRecord long_game() {
+	std::vector<std::unique_ptr<Cluedo::Strategy>> strategies;
+	std::vector<Cluedo::Strategy*> players;
+	for (std::size_t i = 0; i < 3; ++i)
+		players.push_back(strategies.emplace_back(Cluedo::Strategy::create("random")).get());
+
+	for (std::uint64_t game_index = 0;; ++game_index) {
+		auto record = Cluedo::simulate_game(players, {}, 1, game_index).record_for_player(0);
+		if (record.informations.size() >= 3 * SNAPSHOT_INTERVAL)
+			return record;
+	}
+}
+
+static GameLog log_of(Cluedo::GameRecord const& record) {
+	GameLog game_log(Solver::create(record.players).release_value());
+	game_log.append(record.informations);
+	return game_log;
+}
+
+// Returns the state of the solver after every number of information, which depends on the snapshots too.
+static std::vector<std::string> states(GameLog const& game_log) {
+	std::vector<std::string> states;
+	for (std::size_t i = 0; i <= game_log.informations().size(); ++i)
+		states.push_back(game_log.solver_after(i).to_binary().release_value());
+
+	states.push_back(game_log.solver().to_binary().release_value());
+	return states;
+}
+
+// Checks that the log is the same as one built from scratch with the same information.
+static bool matches_rebuilt_log(GameLog const& game_log, Cluedo::GameRecord record) {
+	record.informations.assign(game_log.informations().begin(), game_log.informations().end());
+	auto rebuilt_log = log_of(record);
+	return rebuilt_log.informations().size() == record.informations.size() && states(rebuilt_log) == states(game_log);
+}
+
+// The indices just before, on and just after the snapshots, and the last one.
+static std::vector<std::size_t> edited_indices(std::size_t information_count) {
+	std::vector<std::size_t> indices { 0, 1 };
+	for (auto boundary = SNAPSHOT_INTERVAL; boundary + 1 < information_count; boundary += SNAPSHOT_INTERVAL)
+		indices.insert(indices.end(), { boundary - 1, boundary, boundary + 1 });
+
+	indices.push_back(information_count - 1);
+	return indices;
+}
+
+static void test_replace() {
+	auto record = long_game();
+	for (auto index : edited_indices(record.informations.size())) {
+		auto game_log = log_of(record);
+		// The information of the first player's hand is valid anywhere after it.
+		auto new_index = index == 0 ? 0 : index - 1;
+		CHECK(game_log.replace(index, record.informations[new_index]));
+		CHECK(matches_rebuilt_log(game_log, record));
+	}
+}
+
+static void test_remove() {
+	auto record = long_game();
+	for (auto index : edited_indices(record.informations.size())) {
+		auto game_log = log_of(record);
+		CHECK(game_log.remove(index));
+		CHECK(game_log.informations().size() == record.informations.size() - 1);
+		CHECK(matches_rebuilt_log(game_log, record));
+
+		// The log can still be extended and undone after the edit.
+		CHECK(game_log.append(record.informations.back()));
+		game_log.remove_last();
+		CHECK(matches_rebuilt_log(game_log, record));
+	}
+}
+
+static void test_remove_last() {
+	auto record = long_game();
+	auto game_log = log_of(record);
+	while (!game_log.informations().empty()) {
+		game_log.remove_last();
+		CHECK(matches_rebuilt_log(game_log, record));
+	}
+}
+
+static void test_replace_with_contradiction() {
+	auto record = long_game();
+	auto const& hand_card = std::get<Solver::PlayerCardState>(record.informations.front());
+	for (auto index : edited_indices(record.informations.size())) {
+		if (index == 0)
+			continue;
+
+		auto game_log = log_of(record);
+		auto states_before = states(game_log);
+		auto memory_usage_before = game_log.memory_usage();
+
+		// The first player can't lack a card of their hand.
+		CHECK(!game_log.replace(index, Solver::PlayerCardState { hand_card.player_index, hand_card.card, false }));
+		CHECK(game_log.informations().size() == record.informations.size());
+		CHECK(matches_rebuilt_log(game_log, record));
+		CHECK(states(game_log) == states_before);
+		CHECK(game_log.memory_usage() == memory_usage_before);
+	}
+}
+
+int main() {
+	test_replace();
+	test_remove();
+	test_remove_last();
+	test_replace_with_contradiction();
+	return Cluedo::Tests::exit_code();
+}
@@ -0,0 +1,92 @@
+// Tests the game records in the binary format (CLGR).
+
+#include "GameRecord.hpp"
+#include "Test.hpp"
+
+using Cluedo::Card;
+using Cluedo::GameRecord;
+using Cluedo::GameRecordView;
+using Cluedo::Solver;
+
+static GameRecord sample_record() {
+	return {
+		{ { "Alice", 6 }, { "Bob", 6 }, { "Carol", 6 } },
+		{
+		  Solver::PlayerCardState { 0, Card::Knife, true },
+		  Solver::Suggestion { 1, Card::Plum, Card::Rope, Card::Hall, 2, Card::Rope },
+		  Solver::Suggestion { 2, Card::Green, Card::Pipe, Card::Study, 0, std::nullopt },
+		  Solver::Suggestion { 0, Card::Scarlet, Card::Wrench, Card::Lounge, std::nullopt, std::nullopt },
+		},
+	};
+}
+
+// The offset of the first information of the sample record: the magic, the
+// version, the number of players, their cards and names and the number of information.
+static constexpr std::size_t FIRST_INFORMATION_OFFSET = 4 + 1 + 1 + 3 * 2 + 5 + 3 + 5 + 4;
+
+static void test_round_trip() {
+	auto record = sample_record();
+	auto data = record.to_binary().release_value();
+	auto maybe_loaded_record = GameRecord::from_binary(data);
+	CHECK(maybe_loaded_record.is_value());
+	if (maybe_loaded_record.is_error())
+		return;
+
+	auto loaded_record = maybe_loaded_record.release_value();
+	CHECK(loaded_record.to_json() == record.to_json());
+	CHECK(loaded_record.to_binary().release_value() == data);
+	CHECK(data.size() == FIRST_INFORMATION_OFFSET + record.informations.size() * GameRecordView::BINARY_INFORMATION_SIZE);
+}
+
+static void test_records_that_cant_be_converted() {
+	auto record = sample_record();
+	record.players[0].name = std::string(256, 'A');
+	CHECK(record.to_binary().is_error());
+
+	record = sample_record();
+	record.informations.push_back(Solver::Suggestion { 1, Card::Plum, Card::Rope, Card::Hall, 1, std::nullopt });
+	CHECK(record.to_binary().is_error());
+}
+
+static void test_truncated_data() {
+	auto data = sample_record().to_binary().release_value();
+	for (std::size_t size = 0; size < data.size(); ++size)
+		CHECK(GameRecordView::from_binary(std::string_view(data).substr(0, size)).is_error());
+
+	CHECK(GameRecordView::from_binary(data + '\0').is_error());
+}
+
+static void test_corrupted_data() {
+	auto data = sample_record().to_binary().release_value();
+	auto corrupted = [&data](std::size_t offset, char byte) {
+		auto copy = data;
+		copy[offset] = byte;
+		return copy;
+	};
+
+	CHECK(GameRecordView::from_binary(corrupted(0, 'X')).is_error()); // The magic.
+	CHECK(GameRecordView::from_binary(corrupted(4, 2)).is_error());   // The version.
+	CHECK(GameRecordView::from_binary(corrupted(5, 0)).is_error());   // The number of players.
+	CHECK(GameRecordView::from_binary(corrupted(5, 7)).is_error());
+	CHECK(GameRecordView::from_binary(corrupted(FIRST_INFORMATION_OFFSET - 4, 5)).is_error()); // The number of information.
+
+	// A player that is not in the game.
+	CHECK(GameRecordView::from_binary(corrupted(FIRST_INFORMATION_OFFSET, 3 << 1)).is_error());
+	// A card that doesn't exist, the 31st.
+	auto unknown_card = corrupted(FIRST_INFORMATION_OFFSET, static_cast<char>(data[FIRST_INFORMATION_OFFSET] | '\xe0'));
+	unknown_card[FIRST_INFORMATION_OFFSET + 1] = static_cast<char>(data[FIRST_INFORMATION_OFFSET + 1] | '\x03');
+	CHECK(GameRecordView::from_binary(unknown_card).is_error());
+	// Bits that aren't used by any field.
+	CHECK(GameRecordView::from_binary(corrupted(FIRST_INFORMATION_OFFSET + 2, '\x08')).is_error());
+	// The player who made the second suggestion responding to it.
+	auto second_information = FIRST_INFORMATION_OFFSET + GameRecordView::BINARY_INFORMATION_SIZE;
+	CHECK(GameRecordView::from_binary(corrupted(second_information, static_cast<char>((data[second_information] & 0x8f) | 1 << 4))).is_error());
+}
+
+int main() {
+	test_round_trip();
+	test_records_that_cant_be_converted();
+	test_truncated_data();
+	test_corrupted_data();
+	return Cluedo::Tests::exit_code();
+}
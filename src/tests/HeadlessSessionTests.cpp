@@ -0,0 +1,86 @@
+// Tests the responses of the solves of a headless session, when they are over and when the pool is destroyed.
+
+#include "HeadlessSession.hpp"
+#include "Test.hpp"
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+using Cluedo::HeadlessSession;
+using Cluedo::Json;
+using Cluedo::SolverPool;
+
+using namespace std::literals;
+
+static constexpr std::size_t SOLVE_COUNT = 8;
+
+// The responses given by a session, which the solves give from the threads of the pool.
+struct Responses {
+	std::mutex mutex;
+	std::vector<Json> responses;
+
+	HeadlessSession::Respond respond() {
+		return [this](Json&& response) {
+			std::lock_guard lock(mutex);
+			responses.push_back(std::move(response));
+		};
+	}
+};
+
+static void start_game(HeadlessSession& session, Responses& responses) {
+	session.handle_request(R"({ "id": 0, "command": "new_game", "players": [ { "name": "A", "card_count": 6 }, { "name": "B", "card_count": 6 }, { "name": "C", "card_count": 6 } ] })"sv, responses.respond());
+	CHECK(responses.responses.size() == 1 && responses.responses.back()["ok"] == true);
+	responses.responses.clear();
+}
+
+static void test_finished_solve() {
+	SolverPool solver_pool(1);
+	HeadlessSession session(solver_pool);
+	Responses responses;
+	start_game(session, responses);
+
+	session.handle_request(R"({ "id": 1, "command": "solve" })"sv, responses.respond());
+	session.wait();
+
+	CHECK(responses.responses.size() == 1);
+	auto const& response = responses.responses.front();
+	CHECK(response["id"] == 1);
+	CHECK(response["ok"] == true);
+	CHECK(response["sample_count"].get<std::size_t>() > 0);
+	CHECK(!response["solutions"].empty());
+}
+
+static void test_solves_cancelled_by_the_pool() {
+	std::optional<SolverPool> solver_pool(std::in_place, 1);
+	HeadlessSession session(*solver_pool);
+	Responses responses;
+	start_game(session, responses);
+
+	for (std::size_t i = 0; i < SOLVE_COUNT; ++i)
+		session.handle_request(Json { { "id", i }, { "command", "solve" } }, responses.respond());
+
+	// The solve in progress is stopped and the ones still waiting are dropped,
+	// and all of them are answered as cancelled rather than with empty results.
+	solver_pool.reset();
+
+	CHECK(responses.responses.size() == SOLVE_COUNT);
+	std::size_t cancelled_count = 0;
+	for (auto const& response : responses.responses) {
+		if (response["ok"] == true) {
+			CHECK(response["sample_count"].get<std::size_t>() > 0);
+		} else {
+			CHECK(response["error"] == "SolveCancelled");
+			++cancelled_count;
+		}
+	}
+
+	CHECK(cancelled_count >= SOLVE_COUNT - 1);
+	CHECK(session.pending_solve_count() == 0);
+}
+
+int main() {
+	test_finished_solve();
+	test_solves_cancelled_by_the_pool();
+	return Cluedo::Tests::exit_code();
+}
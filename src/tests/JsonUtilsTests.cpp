@@ -0,0 +1,80 @@
+// Tests the conversion of the information of a game from JSON.
+
+#include "JsonUtils.hpp"
+#include "Test.hpp"
+
+using Cluedo::Json;
+using Cluedo::JsonUtils;
+
+static constexpr std::size_t PLAYER_COUNT = 4;
+
+// The indices are parsed, since only the unsigned numbers that come from parsing are valid indices.
+static Json suggestion_json() {
+	return Json::parse(R"({ "type": "suggestion", "player": 0, "suspect": "Plum", "weapon": "Rope", "room": "Hall", "responding_player": 2, "response_card": "Rope" })");
+}
+
+static void test_valid_informations() {
+	auto suggestion = JsonUtils::information_from_json(suggestion_json(), PLAYER_COUNT);
+	CHECK(suggestion && std::holds_alternative<Cluedo::Solver::Suggestion>(*suggestion));
+	if (!suggestion)
+		return;
+
+	auto unanswered = suggestion_json();
+	unanswered.erase("responding_player");
+	unanswered.erase("response_card");
+	CHECK(JsonUtils::information_from_json(unanswered, PLAYER_COUNT));
+
+	auto player_card_state = Json::parse(R"({ "type": "player_card_state", "player": 3, "card": "Knife", "has_card": true })");
+	CHECK(JsonUtils::information_from_json(player_card_state, PLAYER_COUNT));
+
+	// A converted information is converted back to the same JSON.
+	CHECK(JsonUtils::information_to_json(*suggestion) == suggestion_json());
+}
+
+static void test_cards_of_the_wrong_category() {
+	auto swapped = suggestion_json();
+	swapped["suspect"] = "Rope";
+	swapped["weapon"] = "Plum";
+	swapped["response_card"] = "Plum";
+	CHECK(!JsonUtils::information_from_json(swapped, PLAYER_COUNT));
+
+	auto room_as_weapon = suggestion_json();
+	room_as_weapon["weapon"] = "Kitchen";
+	room_as_weapon.erase("response_card");
+	CHECK(!JsonUtils::information_from_json(room_as_weapon, PLAYER_COUNT));
+
+	auto suspect_as_room = suggestion_json();
+	suspect_as_room["room"] = "Scarlet";
+	CHECK(!JsonUtils::information_from_json(suspect_as_room, PLAYER_COUNT));
+}
+
+static void test_response_card_not_suggested() {
+	auto suggestion = suggestion_json();
+	suggestion["response_card"] = "Knife";
+	CHECK(!JsonUtils::information_from_json(suggestion, PLAYER_COUNT));
+}
+
+static void test_player_responding_to_themselves() {
+	auto suggestion = suggestion_json();
+	suggestion["responding_player"] = suggestion["player"];
+	CHECK(!JsonUtils::information_from_json(suggestion, PLAYER_COUNT));
+}
+
+static void test_players_out_of_range() {
+	auto suggestion = suggestion_json();
+	suggestion["player"] = Json(PLAYER_COUNT);
+	CHECK(!JsonUtils::information_from_json(suggestion, PLAYER_COUNT));
+
+	suggestion = suggestion_json();
+	suggestion["responding_player"] = Json(PLAYER_COUNT);
+	CHECK(!JsonUtils::information_from_json(suggestion, PLAYER_COUNT));
+}
+
+int main() {
+	test_valid_informations();
+	test_cards_of_the_wrong_category();
+	test_response_card_not_suggested();
+	test_player_responding_to_themselves();
+	test_players_out_of_range();
+	return Cluedo::Tests::exit_code();
+}
@@ -0,0 +1,131 @@
+// Tests the creation of the solvers and their state in the binary format (CLSV).
+
+#include "Simulator.hpp"
+#include "Test.hpp"
+
+#include <limits>
+#include <memory>
+
+using Cluedo::CardUtils;
+using Cluedo::Error;
+using Cluedo::Solver;
+
+// Returns the solver of the first player at the end of a simulated game, which knows a bit of everything.
+static Solver solver_after_game(std::uint64_t game_index) {
+	auto first = Cluedo::Strategy::create("deductive");
+	auto second = Cluedo::Strategy::create("deductive");
+	auto third = Cluedo::Strategy::create("deductive");
+	std::vector<Cluedo::Strategy*> strategies { first.get(), second.get(), third.get() };
+	auto record = Cluedo::simulate_game(strategies, {}, 1, game_index).record_for_player(0);
+
+	auto solver = Solver::create(record.players).release_value();
+	for (auto const& information : record.informations)
+		solver.learn(information);
+
+	return solver;
+}
+
+// Checks that the other solver knows at least what the solver knows.
+static bool knows_at_least(Solver const& other, Solver const& solver) {
+	if (solver.player_count() != other.player_count())
+		return false;
+
+	for (std::size_t i = 0; i <= solver.player_count(); ++i) {
+		if (solver.player(i).name() != other.player(i).name() || solver.player(i).card_count() != other.player(i).card_count())
+			return false;
+
+		for (auto card : CardUtils::cards()) {
+			auto has_card = solver.player(i).has_card(card);
+			if (has_card && other.player(i).has_card(card) != has_card)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static void test_card_counts_out_of_range() {
+	// The card counts add up to the right number only because the sum wraps around.
+	auto maybe_solver = Solver::create({ { "A", std::numeric_limits<std::size_t>::max() }, { "B", 19 } });
+	CHECK(maybe_solver.is_error() && maybe_solver.release_error() == Error::InvalidNumberOfCards);
+
+	CHECK(Solver::create({ { "A", CardUtils::CARD_COUNT + 1 }, { "B", 0 } }).is_error());
+	CHECK(Solver::create({ { "A", 9 }, { "B", 9 } }).is_value());
+}
+
+static void test_round_trip() {
+	for (std::uint64_t game_index = 0; game_index < 20; ++game_index) {
+		auto solver = solver_after_game(game_index);
+		auto maybe_data = solver.to_binary();
+		CHECK(maybe_data.is_value());
+		if (maybe_data.is_error())
+			continue;
+
+		auto data = maybe_data.release_value();
+		auto maybe_loaded_solver = Solver::from_binary(data);
+		CHECK(maybe_loaded_solver.is_value());
+		if (maybe_loaded_solver.is_error())
+			continue;
+
+		auto loaded_solver = maybe_loaded_solver.release_value();
+		CHECK(knows_at_least(loaded_solver, solver));
+		CHECK(loaded_solver.are_constraints_satisfied());
+
+		// The inference is run again on load, so it can only learn more, but the state it loads is stable.
+		auto loaded_data = loaded_solver.to_binary().release_value();
+		auto maybe_reloaded_solver = Solver::from_binary(loaded_data);
+		CHECK(maybe_reloaded_solver.is_value() && maybe_reloaded_solver.release_value().to_binary().release_value() == loaded_data);
+	}
+}
+
+static void test_long_names() {
+	auto solver = Solver::create({ { std::string(256, 'A'), 9 }, { "B", 9 } }).release_value();
+	auto maybe_data = solver.to_binary();
+	CHECK(maybe_data.is_error() && maybe_data.release_error() == Error::InvalidSolverState);
+}
+
+static void test_truncated_data() {
+	auto data = solver_after_game(0).to_binary().release_value();
+	for (std::size_t size = 0; size < data.size(); ++size)
+		CHECK(Solver::from_binary(std::string_view(data).substr(0, size)).is_error());
+
+	CHECK(Solver::from_binary(data + '\0').is_error());
+}
+
+static void test_corrupted_data() {
+	auto data = solver_after_game(0).to_binary().release_value();
+	auto corrupted = [&data](std::size_t offset, char byte) {
+		auto copy = data;
+		copy[offset] = byte;
+		return copy;
+	};
+
+	CHECK(Solver::from_binary(corrupted(0, 'X')).is_error()); // The magic.
+	CHECK(Solver::from_binary(corrupted(4, 2)).is_error());   // The version.
+	CHECK(Solver::from_binary(corrupted(5, 0)).is_error());   // The number of players.
+	CHECK(Solver::from_binary(corrupted(5, 7)).is_error());
+	CHECK(Solver::from_binary(corrupted(6, 2)).is_error()); // Whether there is a contradiction.
+
+	// The cards in the hand of the first player, which would then hold every card.
+	std::size_t offset = 7;
+	auto solver = Solver::from_binary(data).release_value();
+	for (std::size_t i = 0; i < solver.player_count(); ++i)
+		offset += 2 + solver.player(i).name().size();
+
+	auto every_card = corrupted(offset, '\xff');
+	every_card[offset + 1] = '\xff';
+	every_card[offset + 2] = '\x1f';
+	CHECK(Solver::from_binary(every_card).is_error());
+
+	// A card that doesn't exist.
+	CHECK(Solver::from_binary(corrupted(offset + 3, '\x01')).is_error());
+}
+
+int main() {
+	test_card_counts_out_of_range();
+	test_round_trip();
+	test_long_names();
+	test_truncated_data();
+	test_corrupted_data();
+	return Cluedo::Tests::exit_code();
+}
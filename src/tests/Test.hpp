@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdlib>
+#include <fmt/core.h>
+
+/// \file Test.hpp
+/// \brief The file that contains the checks used by the tests of the engine.
+///
+/// Every test is a program that runs its checks and exits with a failure if
+/// any of them didn't hold, so that it can be run by CTest.
+
+namespace Cluedo::Tests {
+
+inline std::size_t failed_check_count = 0;
+
+/// Records the result of a check, printing it if it didn't hold.
+///
+/// \param condition The result of the check.
+/// \param expression The expression that was checked.
+/// \param file The file of the check.
+/// \param line The line of the check.
+inline void check(bool condition, char const* expression, char const* file, int line) {
+	if (condition)
+		return;
+
+	++failed_check_count;
+	fmt::println(stderr, "{}:{}: check failed: {}", file, line, expression);
+}
+
+/// Returns the exit code of the test.
+///
+/// \return `EXIT_SUCCESS` if all the checks held, `EXIT_FAILURE` otherwise.
+inline int exit_code() {
+	if (failed_check_count == 0)
+		return EXIT_SUCCESS;
+
+	fmt::println(stderr, "{} checks failed", failed_check_count);
+	return EXIT_FAILURE;
+}
+
+}
+
+/// \def CHECK
+/// \brief Checks that an expression is `true`, without stopping the test if it isn't.
+#define CHECK(...) ::Cluedo::Tests::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
@@ -0,0 +1,257 @@
+// Plays games between strategies and compares how often each of them wins.
+//
+// Usage: cluedo-tournament [options] <strategies...>
+//
+// Every game seats the strategies given (see Strategy.hpp), from 2 to 6 of
+// them, rotated by one seat at every game, so that each of them plays as
+// often from every seat. The games are played in parallel, but each one only
+// depends on the seed and its index, so the same options always give the
+// same results, whatever the number of threads.
+//
+// The results are written as JSON: for each strategy, its win rate with its
+// 95% confidence interval, how often it made a wrong accusation and the time
+// spent by its solver for each decision.
+
+#include "JsonUtils.hpp"
+#include "Simulator.hpp"
+#include "ToolUtils.hpp"
+#include "utils/Result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fmt/core.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+using Cluedo::Json;
+using Cluedo::ToolUtils;
+
+static constexpr auto USAGE = R"(Usage: cluedo-tournament [options] <strategies...>
+
+Options:
+  -n, --games <count>            Play this many games, by default 100000.
+  -s, --seed <seed>              The seed of the games, by default 1.
+  -m, --max-suggestions <count>  Abandon a game after this many suggestions, by default 200.
+  -j, --jobs <count>             Play this many games at a time, by default as many as the cores.
+  -l, --list                     List the built-in strategies.
+  -h, --help                     Show this message.
+)"sv;
+
+struct Options {
+	std::vector<std::string_view> strategy_names;
+	std::size_t game_count { 100'000 };
+	std::uint64_t seed { 1 };
+	Cluedo::SimulationOptions simulation;
+	std::size_t job_count { std::max(1u, std::thread::hardware_concurrency()) };
+};
+
+static Result<Options, std::string> parse_arguments(std::vector<std::string_view> const& arguments) {
+	Options options;
+	for (std::size_t i = 0; i < arguments.size(); ++i) {
+		auto argument = arguments[i];
+		if (!argument.starts_with('-')) {
+			if (!Cluedo::Strategy::create(argument))
+				return fmt::format("unknown strategy '{}'", argument);
+
+			options.strategy_names.push_back(argument);
+			continue;
+		}
+
+		// Every option takes a value.
+		if (i + 1 == arguments.size())
+			return fmt::format("missing value after '{}'", argument);
+
+		auto value = arguments[++i];
+		if (argument == "-n"sv || argument == "--games"sv) {
+			if (!ToolUtils::parse_number(value, options.game_count))
+				return fmt::format("invalid number of games '{}'", value);
+		} else if (argument == "-s"sv || argument == "--seed"sv) {
+			if (!ToolUtils::parse_number(value, options.seed))
+				return fmt::format("invalid seed '{}'", value);
+		} else if (argument == "-m"sv || argument == "--max-suggestions"sv) {
+			if (!ToolUtils::parse_number(value, options.simulation.max_suggestion_count))
+				return fmt::format("invalid number of suggestions '{}'", value);
+		} else if (argument == "-j"sv || argument == "--jobs"sv) {
+			if (!ToolUtils::parse_number(value, options.job_count) || options.job_count == 0)
+				return fmt::format("invalid number of jobs '{}'", value);
+		} else {
+			return fmt::format("unknown option '{}'", argument);
+		}
+	}
+
+	if (options.strategy_names.size() < Cluedo::Solver::MIN_PLAYER_COUNT || options.strategy_names.size() > Cluedo::Solver::MAX_PLAYER_COUNT)
+		return fmt::format("from {} to {} strategies must be given", Cluedo::Solver::MIN_PLAYER_COUNT, Cluedo::Solver::MAX_PLAYER_COUNT);
+
+	return options;
+}
+
+// Returns the 95% Wilson score interval of the probability of an event, given how many times it happened.
+static std::pair<double, double> confidence_interval(std::size_t event_count, std::size_t trial_count) {
+	if (trial_count == 0)
+		return { 0.0, 1.0 };
+
+	constexpr double z = 1.959963984540054;
+	auto n = static_cast<double>(trial_count);
+	auto p = static_cast<double>(event_count) / n;
+	auto denominator = 1.0 + z * z / n;
+	auto center = (p + z * z / (2.0 * n)) / denominator;
+	auto margin = z * std::sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / denominator;
+	return { std::max(0.0, center - margin), std::min(1.0, center + margin) };
+}
+
+static double microseconds_per_event(std::chrono::nanoseconds time, std::size_t event_count) {
+	return event_count > 0 ? std::chrono::duration<double, std::micro>(time).count() / static_cast<double>(event_count) : 0.0;
+}
+
+// The results of some games, which are kept by each thread and then merged.
+struct Results {
+	struct Standing {
+		std::size_t win_count { 0 };
+		std::size_t wrong_accusation_count { 0 };
+		Cluedo::PlayerTimings timings;
+	};
+
+	std::size_t game_count { 0 };
+	std::size_t abandoned_game_count { 0 };
+	std::size_t inconsistent_game_count { 0 };
+	std::vector<Standing> standings; // Indexed by the strategy, not by the seat.
+
+	// Adds a game in which the player at each seat played the strategy at the seat plus the rotation.
+	void add_game(Cluedo::SimulatedGame const& game, std::size_t rotation) {
+		auto strategy_index = [this, rotation](std::size_t player_index) { return (player_index + rotation) % standings.size(); };
+
+		++game_count;
+		abandoned_game_count += !game.winner_index;
+		inconsistent_game_count += !game.is_consistent;
+		if (game.winner_index)
+			++standings[strategy_index(*game.winner_index)].win_count;
+
+		for (auto player_index : game.eliminated_player_indices)
+			++standings[strategy_index(player_index)].wrong_accusation_count;
+
+		for (std::size_t i = 0; i < game.player_timings.size(); ++i)
+			add_timings(standings[strategy_index(i)].timings, game.player_timings[i]);
+	}
+
+	void merge(Results const& other) {
+		game_count += other.game_count;
+		abandoned_game_count += other.abandoned_game_count;
+		inconsistent_game_count += other.inconsistent_game_count;
+		for (std::size_t i = 0; i < standings.size(); ++i) {
+			standings[i].win_count += other.standings[i].win_count;
+			standings[i].wrong_accusation_count += other.standings[i].wrong_accusation_count;
+			add_timings(standings[i].timings, other.standings[i].timings);
+		}
+	}
+
+	Json to_json(std::vector<std::string_view> const& strategy_names) const {
+		Json strategies = Json::array();
+		for (std::size_t i = 0; i < standings.size(); ++i) {
+			auto const& standing = standings[i];
+			auto const& timings = standing.timings;
+			auto [low, high] = confidence_interval(standing.win_count, game_count);
+			strategies.push_back({
+			  { "strategy", strategy_names[i] },
+			  { "win_count", standing.win_count },
+			  { "win_rate", game_count > 0 ? static_cast<double>(standing.win_count) / static_cast<double>(game_count) : 0.0 },
+			  { "win_rate_confidence_interval", { low, high } },
+			  { "wrong_accusation_count", standing.wrong_accusation_count },
+			  { "decision_count", timings.decision_count },
+			  { "decision_time_us", microseconds_per_event(timings.decision_time, timings.decision_count) },
+			  { "update_time_us", microseconds_per_event(timings.update_time, timings.update_count) },
+			  { "solver_time_per_decision_us", microseconds_per_event(timings.decision_time + timings.update_time, timings.decision_count) },
+			});
+		}
+
+		return {
+			{ "game_count", game_count },
+			{ "abandoned_game_count", abandoned_game_count },
+			{ "inconsistent_game_count", inconsistent_game_count },
+			{ "strategies", std::move(strategies) },
+		};
+	}
+
+private:
+	static void add_timings(Cluedo::PlayerTimings& timings, Cluedo::PlayerTimings const& other) {
+		timings.decision_count += other.decision_count;
+		timings.decision_time += other.decision_time;
+		timings.update_count += other.update_count;
+		timings.update_time += other.update_time;
+	}
+};
+
+Result<void, std::string> my_main(std::vector<std::string_view>&& arguments) {
+	if (ToolUtils::has_option(arguments, "-h"sv, "--help"sv)) {
+		fmt::print("{}", USAGE);
+		return {};
+	}
+
+	if (ToolUtils::has_option(arguments, "-l"sv, "--list"sv)) {
+		for (auto name : Cluedo::Strategy::built_in_names())
+			fmt::println("{}", name);
+		return {};
+	}
+
+	auto maybe_options = parse_arguments(arguments);
+	if (maybe_options.is_error())
+		return fmt::format("{}\n\n{}", maybe_options.release_error(), USAGE);
+
+	auto options = maybe_options.release_value();
+	options.simulation.measure_time = true;
+	auto strategy_count = options.strategy_names.size();
+	auto start_time = std::chrono::steady_clock::now();
+
+	std::atomic<std::size_t> next_game_index { 0 };
+	auto thread_count = std::max<std::size_t>(1, std::min(options.job_count, options.game_count));
+	std::vector<Results> thread_results(thread_count, Results { .standings = std::vector<Results::Standing>(strategy_count) });
+	{
+		std::vector<std::jthread> workers;
+		for (std::size_t thread = 0; thread < thread_count; ++thread) {
+			workers.emplace_back([&, &results = thread_results[thread]]() {
+				// Each thread has its own strategies, since they keep their state during a game.
+				std::vector<std::unique_ptr<Cluedo::Strategy>> strategies;
+				for (auto name : options.strategy_names)
+					strategies.push_back(Cluedo::Strategy::create(name));
+
+				std::vector<Cluedo::Strategy*> players(strategy_count);
+				for (auto begin = next_game_index.fetch_add(ToolUtils::GAMES_PER_BATCH); begin < options.game_count; begin = next_game_index.fetch_add(ToolUtils::GAMES_PER_BATCH)) {
+					for (auto index = begin; index < std::min(begin + ToolUtils::GAMES_PER_BATCH, options.game_count); ++index) {
+						auto rotation = index % strategy_count;
+						for (std::size_t i = 0; i < strategy_count; ++i)
+							players[i] = strategies[(i + rotation) % strategy_count].get();
+
+						results.add_game(Cluedo::simulate_game(players, options.simulation, options.seed, index), rotation);
+					}
+				}
+			});
+		}
+	}
+
+	Results results { .standings = std::vector<Results::Standing>(strategy_count) };
+	for (auto const& thread_result : thread_results)
+		results.merge(thread_result);
+
+	fmt::println("{}", results.to_json(options.strategy_names).dump());
+
+	auto elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	fmt::println(stderr, "played {} games in {:.3f} s ({:.0f} games/s) with {} threads", results.game_count, elapsed_seconds, static_cast<double>(results.game_count) / elapsed_seconds, thread_count);
+
+	// A solver that contradicts the deal has a bug, which would make the results meaningless.
+	if (results.inconsistent_game_count > 0)
+		return fmt::format("{} of {} games were contradicted by a solver", results.inconsistent_game_count, results.game_count);
+
+	return {};
+}
+
+int main(int argc, char** argv) {
+	return ToolUtils::run_main(argc, argv, my_main);
+}
@@ -63,10 +63,10 @@ void show_optional_player_combobox(char const* id, Solver const& solver, size_t
 template<typename CardIterator>
 void show_card_combobox(char const* id, CardIterator cards_iterator, Card& selection) {
 	ImGui::PushID(id);
-	if (ImGui::BeginCombo("##", fmt::format("{}", selection).c_str(), ImGuiComboFlags_WidthFitPreview)) {
+	if (ImGui::BeginCombo("##", CSTR(LS(selection)), ImGuiComboFlags_WidthFitPreview)) {
 		for (auto card : cards_iterator) {
 			bool is_selected = selection == card;
-			if (ImGui::Selectable(fmt::format("{}", card).c_str(), is_selected)) {
+			if (ImGui::Selectable(CSTR(LS(card)), is_selected)) {
 				selection = card;
 			}
 			if (is_selected) {
@@ -79,40 +79,31 @@ void show_card_combobox(char const* id, CardIterator cards_iterator, Card& selec
 }
 
 void AddInformationModal::PlayerCardStateTab::reset() {
-	m_player_index = 0;
-	m_card = *CardUtils::cards().begin();
-	m_card_state = true;
+	m_player_card_state.player_index = 0;
+	m_player_card_state.card = *CardUtils::cards().begin();
+	m_player_card_state.has_card = true;
 }
 
-void AddInformationModal::PlayerCardStateTab::show(AddInformationModal::Tab& tab, Solver& solver) {
-	if (ImGui::BeginTabItem(CSTR(LS("UI.PlayerHasHasntGotACard")))) {
+void AddInformationModal::PlayerCardStateTab::reset(Solver::PlayerCardState const& player_card_state) {
+	m_player_card_state = player_card_state;
+}
+
+void AddInformationModal::PlayerCardStateTab::show(AddInformationModal::Tab& tab, Solver const& solver, bool select) {
+	if (ImGui::BeginTabItem(CSTR(LS("UI.PlayerHasHasntGotACard")), nullptr, select ? ImGuiTabItemFlags_SetSelected : ImGuiTabItemFlags_None)) {
 		tab = AddInformationModal::Tab::PlayerCardState;
 
-		show_player_combobox("player-combobox", solver, m_player_index);
+		show_player_combobox("player-combobox", solver, m_player_card_state.player_index);
 
 		ImGui::SameLine();
-		ImGui::Checkbox(CSTR(LS(m_card_state ? "UI.HasGot" : "UI.HasntGot")), &m_card_state);
+		ImGui::Checkbox(CSTR(m_player_card_state.has_card ? LS("UI.HasGot") : LS("UI.HasntGot")), &m_player_card_state.has_card);
 
 		ImGui::SameLine();
-		show_card_combobox("card-combobox", CardUtils::cards(), m_card);
+		show_card_combobox("card-combobox", CardUtils::cards(), m_player_card_state.card);
 
 		ImGui::EndTabItem();
 	}
 }
 
-void AddInformationModal::PlayerCardStateTab::learn(Solver& solver) {
-	solver.learn_player_card_state(m_player_index, m_card, m_card_state);
-}
-
-std::string AddInformationModal::PlayerCardStateTab::compute_information_string(Solver const& solver) {
-	return fmt::format(
-	  "{} {} {}",
-	  solver.player(m_player_index).name(),
-	  LS(m_card_state ? "UI.HasGot" : "UI.HasntGot"),
-	  m_card
-	);
-}
-
 void AddInformationModal::SuggestionTab::reset() {
 	m_suggestion.suggesting_player_index = 0;
 	m_suggestion.suspect = *CardUtils::cards_per_category(CardCategory::Suspect).begin();
@@ -122,8 +113,12 @@ void AddInformationModal::SuggestionTab::reset() {
 	m_suggestion.response_card.reset();
 }
 
-void AddInformationModal::SuggestionTab::show(Tab& tab, Solver& solver) {
-	if (ImGui::BeginTabItem(CSTR(LS("UI.PlayerMadeASuggestion")))) {
+void AddInformationModal::SuggestionTab::reset(Solver::Suggestion const& suggestion) {
+	m_suggestion = suggestion;
+}
+
+void AddInformationModal::SuggestionTab::show(Tab& tab, Solver const& solver, bool select) {
+	if (ImGui::BeginTabItem(CSTR(LS("UI.PlayerMadeASuggestion")), nullptr, select ? ImGuiTabItemFlags_SetSelected : ImGuiTabItemFlags_None)) {
 		tab = AddInformationModal::Tab::Suggestion;
 
 		show_player_combobox("suggesting-player-combobox", solver, m_suggestion.suggesting_player_index);
@@ -143,12 +138,12 @@ void AddInformationModal::SuggestionTab::show(Tab& tab, Solver& solver) {
 		show_optional_player_combobox("responding-player-combobox", solver, m_suggestion.suggesting_player_index, m_suggestion.responding_player_index);
 
 		ImGui::SameLine();
-		ImGui::TextUnformatted(CSTR(LS(m_suggestion.responding_player_index ? "UI.RespondedWith" : "UI.Responded")));
+		ImGui::TextUnformatted(CSTR(m_suggestion.responding_player_index ? LS("UI.RespondedWith") : LS("UI.Responded")));
 
 		if (m_suggestion.responding_player_index) {
 			ImGui::SameLine();
 			ImGui::PushID("response-card-combobox");
-			if (ImGui::BeginCombo("##", m_suggestion.response_card ? fmt::format("{}", *m_suggestion.response_card).c_str() : CSTR(LS("UI.Unknown")), ImGuiComboFlags_WidthFitPreview)) {
+			if (ImGui::BeginCombo("##", m_suggestion.response_card ? CSTR(LS(*m_suggestion.response_card)) : CSTR(LS("UI.Unknown")), ImGuiComboFlags_WidthFitPreview)) {
 				if (ImGui::Selectable(CSTR(LS("UI.Unknown")), !m_suggestion.response_card)) {
 					m_suggestion.response_card.reset();
 				}
@@ -159,7 +154,7 @@ void AddInformationModal::SuggestionTab::show(Tab& tab, Solver& solver) {
 
 				for (auto card : { m_suggestion.suspect, m_suggestion.weapon, m_suggestion.room }) {
 					bool is_selected = m_suggestion.response_card == card;
-					if (ImGui::Selectable(fmt::format("{}", card).c_str(), is_selected)) {
+					if (ImGui::Selectable(CSTR(LS(card)), is_selected)) {
 						m_suggestion.response_card = card;
 					}
 
@@ -177,16 +172,25 @@ void AddInformationModal::SuggestionTab::show(Tab& tab, Solver& solver) {
 	}
 }
 
-void AddInformationModal::SuggestionTab::learn(Solver& solver) {
-	solver.learn_from_suggestion(m_suggestion);
+std::string AddInformationModal::describe(Solver::Information const& information, Solver const& solver) {
+	return std::visit([&solver](auto const& i) { return describe(i, solver); }, information);
 }
 
-std::string AddInformationModal::SuggestionTab::compute_information_string(Solver const& solver) {
+std::string AddInformationModal::describe(Solver::PlayerCardState const& player_card_state, Solver const& solver) {
+	return fmt::format(
+	  "{} {} {}",
+	  solver.player(player_card_state.player_index).name(),
+	  player_card_state.has_card ? LS("UI.HasGot") : LS("UI.HasntGot"),
+	  LS(player_card_state.card)
+	);
+}
+
+std::string AddInformationModal::describe(Solver::Suggestion const& suggestion, Solver const& solver) {
 	std::string response = std::string { LS("UI.NoOneResponded") };
-	if (m_suggestion.responding_player_index) {
-		auto const& responding_player_name = solver.player(*m_suggestion.responding_player_index).name();
-		if (m_suggestion.response_card) {
-			response = fmt::format("{} {} {}", responding_player_name, LS("UI.RespondedWith"), *m_suggestion.response_card);
+	if (suggestion.responding_player_index) {
+		auto const& responding_player_name = solver.player(*suggestion.responding_player_index).name();
+		if (suggestion.response_card) {
+			response = fmt::format("{} {} {}", responding_player_name, LS("UI.RespondedWith"), LS(*suggestion.response_card));
 		} else {
 			response = fmt::format("{} {}", responding_player_name, LS("UI.Responded"));
 		}
@@ -194,34 +198,28 @@ std::string AddInformationModal::SuggestionTab::compute_information_string(Solve
 
 	return fmt::format(
 	  "{} {} {}, {}, {} {} {}",
-	  solver.player(m_suggestion.suggesting_player_index).name(),
+	  solver.player(suggestion.suggesting_player_index).name(),
 	  LS("UI.Suggested"),
-	  m_suggestion.suspect, m_suggestion.weapon, m_suggestion.room,
+	  LS(suggestion.suspect), LS(suggestion.weapon), LS(suggestion.room),
 	  LS("UI.And"),
 	  response
 	);
 }
 
-void AddInformationModal::show_buttons(Solver& solver) {
+void AddInformationModal::show_buttons() {
 	if (ImGui::Button(CSTR(LS("UI.Learn")))) {
-		auto old_solver = solver;
-		std::string information;
-
+		Solver::Information information;
 		if (m_selected_tab == Tab::PlayerCardState) {
-			m_player_card_state_tab.learn(solver);
-			information = m_player_card_state_tab.compute_information_string(solver);
+			information = m_player_card_state_tab.information();
 		} else if (m_selected_tab == Tab::Suggestion) {
-			m_suggestion_tab.learn(solver);
-			information = m_suggestion_tab.compute_information_string(solver);
+			information = m_suggestion_tab.information();
 		}
 
-		if (!solver.are_constraints_satisfied()) {
-			solver = old_solver;
-			m_error_modal.set_error_message(fmt::format("{}: {}!", LS("UI.ErrorWhileLearningNewInformation"), Error::InvalidInformation));
+		if (!m_on_learn_callback(information)) {
+			m_error_modal.set_error_message(fmt::format("{}: {}!", LS("UI.ErrorWhileLearningNewInformation"), LS(Error::InvalidInformation)));
 			ImGui::OpenPopup(CSTR(LS("UI.Error")));
 		} else {
 			m_error_modal.set_error_message("");
-			m_on_learn_callback(std::move(information), std::move(old_solver));
 			ImGui::CloseCurrentPopup();
 		}
 	}
@@ -234,15 +232,43 @@ void AddInformationModal::show_buttons(Solver& solver) {
 
 void AddInformationModal::reset() {
 	m_selected_tab = Tab::PlayerCardState;
+	m_should_select_tab = true;
+	m_is_editing = false;
 	m_player_card_state_tab.reset();
 	m_suggestion_tab.reset();
+	update_title();
+}
+
+void AddInformationModal::reset(Solver::Information const& information) {
+	reset();
+	m_is_editing = true;
+
+	if (auto const* player_card_state = std::get_if<Solver::PlayerCardState>(&information)) {
+		m_selected_tab = Tab::PlayerCardState;
+		m_player_card_state_tab.reset(*player_card_state);
+	} else {
+		m_selected_tab = Tab::Suggestion;
+		m_suggestion_tab.reset(std::get<Solver::Suggestion>(information));
+	}
+
+	update_title();
 }
 
-void AddInformationModal::show(Solver& solver) {
-	if (ImGui::BeginPopupModal(CSTR(LS("UI.AddInformation")), nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+void AddInformationModal::update_title() {
+	// The title is formatted only when the modal is reset, as the popup is looked up by it every frame.
+	m_title = fmt::format("{}{}", m_is_editing ? LS("UI.EditInformation") : LS("UI.AddInformation"), POPUP_ID);
+}
+
+void AddInformationModal::show(Solver const& solver) {
+	if (ImGui::BeginPopupModal(m_title.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
 		if (ImGui::BeginTabBar("##information-type-tab-bar", ImGuiTabBarFlags_None)) {
-			m_player_card_state_tab.show(m_selected_tab, solver);
-			m_suggestion_tab.show(m_selected_tab, solver);
+			// The tabs overwrite the selected one, so we have to know which one to select before showing them.
+			bool select_player_card_state_tab = m_should_select_tab && m_selected_tab == Tab::PlayerCardState;
+			bool select_suggestion_tab = m_should_select_tab && m_selected_tab == Tab::Suggestion;
+			m_should_select_tab = false;
+
+			m_player_card_state_tab.show(m_selected_tab, solver, select_player_card_state_tab);
+			m_suggestion_tab.show(m_selected_tab, solver, select_suggestion_tab);
 
 			ImGui::EndTabBar();
 		}
@@ -251,7 +277,7 @@ void AddInformationModal::show(Solver& solver) {
 		ImGui::Separator();
 		ImGui::Spacing();
 
-		show_buttons(solver);
+		show_buttons();
 		m_error_modal.show();
 
 		ImGui::EndPopup();
@@ -21,24 +21,46 @@ namespace UI {
 /// The first tab will prompt the user to input the player who has the card or
 /// not and the card in question. The second tab will prompt the user to input
 /// the suggestion made.
+///
+/// The modal is also used to edit information that was already learnt.
 class AddInformationModal {
 public:
+	/// The ID of the popup of the modal.
+	static constexpr char const* POPUP_ID = "###information-modal";
+
 	/// Constructs the modal.
 	///
-	/// \param on_learn_callback The function to be called when the information is
-	/// learnt succesfully.
-	explicit AddInformationModal(std::function<void(std::string&&, Solver&&)> on_learn_callback)
+	/// \param on_learn_callback The function to be called when the user wants the
+	/// information to be learnt, it will return `false` if the information isn't valid.
+	explicit AddInformationModal(std::function<bool(Solver::Information const&)> on_learn_callback)
 	  : m_on_learn_callback(on_learn_callback) {}
 
+	/// Returns the description of a piece of information in the current language.
+	///
+	/// \param information The information to describe.
+	/// \param solver The solver of the game the information belongs to.
+	///
+	/// \return The description of the information.
+	static std::string describe(Solver::Information const& information, Solver const& solver);
+
 	/// Resets the modal data.
 	/// \note Used when the modal has to be opened, so that the old data is lost.
 	void reset();
+	/// Resets the modal data to the given information.
+	/// \note Used when the modal has to be opened to edit the information.
+	///
+	/// \param information The information to edit.
+	void reset(Solver::Information const& information);
 	/// Shows the modal.
 	/// \param solver The solver that contains the game data.
-	void show(Solver& solver);
+	void show(Solver const& solver);
 
 private:
-	void show_buttons(Solver&);
+	void show_buttons();
+	void update_title();
+
+	static std::string describe(Solver::PlayerCardState const&, Solver const&);
+	static std::string describe(Solver::Suggestion const&, Solver const&);
 
 	enum class Tab {
 		PlayerCardState,
@@ -48,33 +70,34 @@ private:
 	class PlayerCardStateTab {
 	public:
 		void reset();
-		void show(Tab&, Solver&);
+		void reset(Solver::PlayerCardState const&);
+		void show(Tab&, Solver const&, bool select);
 
-		void learn(Solver&);
-		std::string compute_information_string(Solver const&);
+		Solver::PlayerCardState const& information() const { return m_player_card_state; }
 
 	private:
-		size_t m_player_index;
-		Card m_card;
-		bool m_card_state;
+		Solver::PlayerCardState m_player_card_state;
 	};
 
 	class SuggestionTab {
 	public:
 		void reset();
-		void show(Tab&, Solver&);
+		void reset(Solver::Suggestion const&);
+		void show(Tab&, Solver const&, bool select);
 
-		void learn(Solver&);
-		std::string compute_information_string(Solver const&);
+		Solver::Suggestion const& information() const { return m_suggestion; }
 
 	private:
 		Solver::Suggestion m_suggestion;
 	};
 
 	Tab m_selected_tab;
+	bool m_should_select_tab { false };
+	bool m_is_editing { false };
+	std::string m_title { POPUP_ID };
 	PlayerCardStateTab m_player_card_state_tab;
 	SuggestionTab m_suggestion_tab;
-	std::function<void(std::string&&, Solver&&)> m_on_learn_callback;
+	std::function<bool(Solver::Information const&)> m_on_learn_callback;
 	ErrorModal m_error_modal;
 };
 
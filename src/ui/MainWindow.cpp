@@ -3,6 +3,7 @@
 #include "../LanguageStrings.hpp"
 #include "../utils/IconsFontAwesome.h"
 
+#include <bit>
 #include <fmt/format.h>
 #include <imgui.h>
 
@@ -10,17 +11,117 @@ namespace Cluedo {
 
 namespace UI {
 
-MainWindow::MainWindow()
-  : m_new_game_modal([this](Solver&& solver) {
-	  m_solver = std::move(solver);
-	  m_solutions = m_solver->find_most_likely_solutions();
+MainWindow::MainWindow(std::function<void()> on_solutions_found)
+  : m_async_solver(std::move(on_solutions_found))
+  , m_new_game_modal([this](Solver&& solver) {
+	  m_game_log.emplace(std::move(solver));
+	  m_estimates_after.assign(1, std::nullopt);
+	  select_information(std::nullopt);
   })
-  , m_add_information_modal([this](std::string&& information, Solver&& solver) {
-	  m_information_history.emplace_back(std::move(information), std::move(solver));
-	  m_solutions = m_solver->find_most_likely_solutions();
+  , m_add_information_modal([this](Solver::Information const& information) {
+	  if (m_edited_information_index)
+		  return edit_information(*m_edited_information_index, information);
+
+	  return learn_information(information);
   }) {
 }
 
+bool MainWindow::learn_information(Solver::Information const& information) {
+	if (!m_game_log->append(information))
+		return false;
+
+	m_estimates_after.emplace_back();
+	select_information(std::nullopt);
+	return true;
+}
+
+bool MainWindow::edit_information(std::size_t index, Solver::Information const& information) {
+	if (!m_game_log->replace(index, information))
+		return false;
+
+	forget_solutions_after(index);
+	return true;
+}
+
+bool MainWindow::remove_information(std::size_t index) {
+	if (!m_game_log->remove(index))
+		return false;
+
+	m_estimates_after.erase(m_estimates_after.begin() + static_cast<ssize_t>(index) + 1);
+	forget_solutions_after(index);
+	return true;
+}
+
+void MainWindow::undo_last_information() {
+	if (m_game_log->informations().empty())
+		return;
+
+	m_game_log->remove_last();
+	m_estimates_after.pop_back();
+	select_information(std::nullopt);
+}
+
+void MainWindow::select_information(std::optional<std::size_t> index) {
+	m_selected_information_index = index;
+	++m_labels_generation;
+
+	auto information_count = shown_information_count();
+	if (m_estimates_after.at(information_count)) {
+		m_async_solver.cancel();
+		m_pending_solutions.reset();
+		return;
+	}
+
+	auto solver = information_count == m_game_log->informations().size() ? m_game_log->solver().snapshot() : m_game_log->solver_after(information_count);
+	m_pending_solutions = { m_async_solver.request(std::move(solver)), information_count };
+}
+
+void MainWindow::forget_solutions_after(std::size_t index) {
+	for (auto i = index + 1; i < m_estimates_after.size(); ++i)
+		m_estimates_after.at(i).reset();
+
+	select_information(std::nullopt);
+}
+
+void MainWindow::take_solver_result() {
+	auto result = m_async_solver.take_result();
+	// The result of a request that was replaced by a newer one is outdated.
+	if (!result || !m_pending_solutions || result->version != m_pending_solutions->version)
+		return;
+
+	m_estimates_after.at(m_pending_solutions->information_count) = Estimate { std::move(result->solutions), std::move(result->card_ownership) };
+	m_pending_solutions.reset();
+	m_partial_result.reset();
+	++m_labels_generation;
+}
+
+void MainWindow::update_information_labels() {
+	LabelsKey key { m_labels_generation, LanguageStrings::the().current_language_id() };
+	if (m_information_labels_key == key)
+		return;
+
+	m_information_labels_key = key;
+	m_undo_button_label = fmt::format("{} {}", ICON_FA_ARROW_ROTATE_LEFT, LS("UI.UndoLastInformation"));
+	m_information_labels.clear();
+	for (auto const& information : m_game_log->informations())
+		m_information_labels.push_back(AddInformationModal::describe(information, m_game_log->solver()));
+}
+
+void MainWindow::update_solution_labels(std::span<Solver::SolutionProbabilityPair const> solutions) {
+	LabelsKey key { m_labels_generation, LanguageStrings::the().current_language_id() };
+	if (m_solution_labels_key == key)
+		return;
+
+	m_solution_labels_key = key;
+	m_solution_labels.clear();
+	for (auto const& [solution, probability] : solutions) {
+		auto [suspect, weapon, room] = solution;
+		auto text = fmt::format("{}, {}, {}", LS(suspect), LS(weapon), LS(room));
+		auto text_width = ImGui::CalcTextSize(text.c_str()).x;
+		m_solution_labels.push_back({ std::move(text), fmt::format("{:.2f}%", probability * 100), text_width, probability });
+	}
+}
+
 void MainWindow::show_game_menu() {
 	if (ImGui::BeginMenu(CSTR(LS("UI.Game")))) {
 		if (ImGui::MenuItem(CSTR(LS("UI.New")), "CTRL+N")) {
@@ -30,12 +131,13 @@ void MainWindow::show_game_menu() {
 
 		ImGui::Separator();
 
-		if (ImGui::MenuItem(CSTR(LS("UI.AddInformation")), "CTRL+Enter", nullptr, m_solver.has_value())) {
+		if (ImGui::MenuItem(CSTR(LS("UI.AddInformation")), "CTRL+Enter", nullptr, m_game_log.has_value())) {
 			m_show_add_information_modal = true;
+			m_edited_information_index.reset();
 			m_add_information_modal.reset();
 		}
 
-		if (ImGui::MenuItem(CSTR(LS("UI.PlayerData")), nullptr, nullptr, m_solver.has_value())) {
+		if (ImGui::MenuItem(CSTR(LS("UI.PlayerData")), nullptr, nullptr, m_game_log.has_value())) {
 			m_show_player_data_modal = true;
 		}
 
@@ -68,6 +170,11 @@ void MainWindow::show_settings_menu() {
 
 			ImGui::EndMenu();
 		}
+
+		ImGui::Separator();
+
+		ImGui::MenuItem(CSTR(LS("UI.PerformanceOverlay")), nullptr, &m_show_performance_overlay);
+
 		ImGui::EndMenu();
 	}
 }
@@ -107,22 +214,47 @@ void MainWindow::show_information_history_section() {
 	}
 
 	if (ImGui::BeginChild("##information-history", { 0.0f, std::min(300.0f, ImGui::GetContentRegionAvail().y * 0.3f) })) {
-		if (m_solver) {
-			auto button_text = fmt::format("{} {}", ICON_FA_ARROW_ROTATE_LEFT, LS("UI.UndoLastInformation"));
-			if (ImGui::Button(button_text.c_str())) {
-				auto [_, solver] = std::move(m_information_history.back());
-				m_information_history.pop_back();
-				m_solver = std::move(solver);
-				m_solutions = m_solver->find_most_likely_solutions();
+		if (m_game_log) {
+			update_information_labels();
+			if (ImGui::Button(m_undo_button_label.c_str())) {
+				undo_last_information();
 			}
 
 			if (ImGui::BeginListBox("##information-history-listbox", { -1, -1 })) {
-				for (std::size_t i = 0; i < m_information_history.size(); ++i) {
-					ImGui::PushID(i);
-					ImGui::Selectable(m_information_history[i].first.c_str());
-					ImGui::PopID();
+				std::optional<std::size_t> information_to_remove_index;
+
+				// Only the visible entries are drawn.
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(m_information_labels.size()));
+				while (clipper.Step()) {
+					for (auto i = static_cast<std::size_t>(clipper.DisplayStart); i < static_cast<std::size_t>(clipper.DisplayEnd); ++i) {
+						ImGui::PushID(i);
+						bool is_selected = m_selected_information_index == i;
+						if (ImGui::Selectable(m_information_labels[i].c_str(), is_selected)) {
+							select_information(is_selected ? std::nullopt : std::optional(i));
+						}
+
+						if (ImGui::BeginPopupContextItem()) {
+							if (ImGui::MenuItem(CSTR(LS("UI.Edit")))) {
+								m_show_add_information_modal = true;
+								m_edited_information_index = i;
+								m_add_information_modal.reset(m_game_log->informations()[i]);
+							}
+
+							if (ImGui::MenuItem(CSTR(LS("UI.Delete")))) {
+								information_to_remove_index = i;
+							}
+
+							ImGui::EndPopup();
+						}
+						ImGui::PopID();
+					}
 				}
 				ImGui::EndListBox();
+
+				// Removing information only loosens the constraints, so the others stay valid.
+				if (information_to_remove_index)
+					remove_information(*information_to_remove_index);
 			}
 		}
 
@@ -130,6 +262,79 @@ void MainWindow::show_information_history_section() {
 	}
 }
 
+std::size_t MainWindow::shown_information_count() const {
+	return m_selected_information_index ? *m_selected_information_index + 1 : m_game_log->informations().size();
+}
+
+void MainWindow::show_solutions(std::span<Solver::SolutionProbabilityPair const> solutions) {
+	update_solution_labels(solutions);
+
+	// Only the visible rows are drawn.
+	ImGuiListClipper clipper;
+	clipper.Begin(static_cast<int>(m_solution_labels.size()));
+	while (clipper.Step()) {
+		for (auto i = static_cast<std::size_t>(clipper.DisplayStart); i < static_cast<std::size_t>(clipper.DisplayEnd); ++i) {
+			auto const& label = m_solution_labels[i];
+			ImGui::TextUnformatted(label.text.c_str());
+			auto available_space = ImGui::GetContentRegionAvail().x - label.text_width;
+			if (available_space < 300.0f) {
+				ImGui::SameLine();
+				ImGui::ProgressBar(label.probability, { 0, 0 }, label.probability_text.c_str());
+			} else {
+				ImGui::SameLine(ImGui::GetContentRegionAvail().x - 300.0f);
+				ImGui::ProgressBar(label.probability, { 300.0f, 0 }, label.probability_text.c_str());
+			}
+		}
+	}
+}
+
+void MainWindow::show_card_ownership(Solver::CardOwnershipProbabilities const& card_ownership) {
+	auto const& solver = m_game_log->solver();
+	if (card_ownership.size() != solver.player_count() + 1)
+		return;
+
+	if (ImGui::BeginTable("##card-ownership", static_cast<int>(card_ownership.size()) + 1, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollX)) {
+		ImGui::TableSetupColumn(CSTR(LS("UI.Card")));
+		for (std::size_t i = 0; i < solver.player_count(); ++i)
+			ImGui::TableSetupColumn(solver.player(i).name().c_str());
+		ImGui::TableSetupColumn(CSTR(LS("UI.Solution")));
+		ImGui::TableHeadersRow();
+
+		// The more likely a player holds a card, the stronger the color of the cell.
+		auto const& heat_color = ImGui::GetStyleColorVec4(ImGuiCol_PlotHistogram);
+		for (auto card : CardUtils::cards()) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(CSTR(LS(card)));
+
+			for (auto const& owner_probabilities : card_ownership) {
+				auto probability = owner_probabilities[static_cast<std::size_t>(card)];
+				ImGui::TableNextColumn();
+				ImGui::TableSetBgColor(ImGuiTableBgTarget_CellBg, ImGui::GetColorU32({ heat_color.x, heat_color.y, heat_color.z, heat_color.w * probability }));
+				ImGui::Text("%.0f%%", probability * 100);
+			}
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+void MainWindow::show_estimate(std::span<Solver::SolutionProbabilityPair const> solutions, Solver::CardOwnershipProbabilities const& card_ownership) {
+	if (ImGui::BeginTabBar("##estimate")) {
+		if (ImGui::BeginTabItem(CSTR(LS("UI.MostLikelySolutions")))) {
+			show_solutions(solutions);
+			ImGui::EndTabItem();
+		}
+
+		if (ImGui::BeginTabItem(CSTR(LS("UI.CardOwners")))) {
+			show_card_ownership(card_ownership);
+			ImGui::EndTabItem();
+		}
+
+		ImGui::EndTabBar();
+	}
+}
+
 void MainWindow::show_solutions_section() {
 	ImGui::SeparatorText(CSTR(LS("UI.Solutions")));
 	if (ImGui::IsItemHovered(ImGuiHoveredFlags_ForTooltip | ImGuiHoveredFlags_DelayNormal)) {
@@ -137,20 +342,28 @@ void MainWindow::show_solutions_section() {
 	}
 
 	if (ImGui::BeginChild("##solutions")) {
-		if (m_solver) {
-			for (auto const& [solution, probability] : m_solutions) {
-				auto [suspect, weapon, room] = solution;
-				auto text = fmt::format("{}, {}, {}", suspect, weapon, room);
-				ImGui::TextUnformatted(text.c_str());
-				auto available_space = ImGui::GetContentRegionAvail().x - ImGui::CalcTextSize(text.c_str()).x;
-				if (available_space < 300.0f) {
-					ImGui::SameLine();
-					ImGui::ProgressBar(probability, { 0, 0 }, fmt::format("{:.2f}%", probability * 100).c_str());
-				} else {
-					ImGui::SameLine(ImGui::GetContentRegionAvail().x - 300.0f);
-					ImGui::ProgressBar(probability, { 300.0f, 0 }, fmt::format("{:.2f}%", probability * 100).c_str());
+		if (m_game_log && m_pending_solutions) {
+			// While the solutions are being computed, the estimates found so far are shown.
+			// They are copied and their labels formatted again only when the number of samples
+			// doubles, instead of every frame, as the estimates change less and less over time.
+			auto version = m_pending_solutions->version;
+			auto sample_count = m_async_solver.partial_sample_count(version);
+			if (sample_count && (!m_partial_result || m_partial_result->version != version || std::bit_floor(*sample_count) != std::bit_floor(m_partial_result->sample_count))) {
+				if (auto partial_result = m_async_solver.partial_result(); partial_result && partial_result->version == version) {
+					m_partial_result = std::move(partial_result);
+					++m_labels_generation;
 				}
 			}
+
+			if (sample_count && m_partial_result && m_partial_result->version == version && !m_partial_result->solutions.empty()) {
+				ImGui::TextDisabled("%s (%s: %zu)", CSTR(LS("UI.ComputingSolutions")), CSTR(LS("UI.Samples")), *sample_count);
+				show_estimate(m_partial_result->solutions, m_partial_result->card_ownership);
+			} else {
+				ImGui::TextDisabled("%s", CSTR(LS("UI.ComputingSolutions")));
+			}
+		} else if (m_game_log && m_estimates_after.at(shown_information_count())) {
+			auto const& estimate = *m_estimates_after.at(shown_information_count());
+			show_estimate(estimate.solutions, estimate.card_ownership);
 		}
 
 		ImGui::EndChild();
@@ -158,10 +371,14 @@ void MainWindow::show_solutions_section() {
 }
 
 void MainWindow::show() {
+	auto show_start = std::chrono::steady_clock::now();
+
 	m_show_new_game_modal = false;
 	m_show_add_information_modal = false;
 	m_show_player_data_modal = false;
 
+	take_solver_result();
+
 	ImGui::SetNextWindowPos({ 0.0f, 0.0f });
 	ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0);
@@ -183,22 +400,28 @@ void MainWindow::show() {
 	}
 	m_new_game_modal.show();
 
-	if (m_solver) {
+	if (m_game_log) {
 		if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Enter)) {
+			m_edited_information_index.reset();
 			m_add_information_modal.reset();
 			m_show_add_information_modal = true;
 		}
 
 		if (m_show_add_information_modal) {
-			ImGui::OpenPopup(CSTR(LS("UI.AddInformation")));
+			ImGui::OpenPopup(AddInformationModal::POPUP_ID);
 		}
-		m_add_information_modal.show(*m_solver);
+		m_add_information_modal.show(m_game_log->solver());
 
 		if (m_show_player_data_modal) {
 			ImGui::OpenPopup(CSTR(LS("UI.PlayerData")));
 		}
-		m_player_data_modal.show(*m_solver);
+		m_player_data_modal.show(m_game_log->solver());
+	}
+
+	if (m_show_performance_overlay) {
+		m_performance_overlay.show(&m_show_performance_overlay);
 	}
+	m_performance_overlay.record_frame(std::chrono::steady_clock::now() - show_start, m_async_solver.statistics());
 }
 
 }
@@ -1,10 +1,14 @@
 #pragma once
 
-#include "../Solver.hpp"
+#include "../AsyncSolver.hpp"
+#include "../GameLog.hpp"
 #include "AddInformationModal.hpp"
 #include "NewGameModal.hpp"
+#include "PerformanceOverlay.hpp"
 #include "PlayerDataModal.hpp"
 
+#include <functional>
+
 /// \file MainWindow.hpp
 /// \brief The file that contains the definition of the \ref Cluedo::UI::MainWindow class.
 
@@ -17,21 +21,33 @@ namespace UI {
 /// This class is responsible for showing the main window of the application.
 /// It has a menubar with three sections:
 /// * _Game_: contains the items _New_ (\ref Cluedo::UI::NewGameModal), _Add information (\ref Cluedo::UI::AddInformationModal)_ and _Player data_ (\ref Cluedo::UI::PlayerDataModal);
-/// * _Settings_: contains the items _Language_ (allows to change the language of the application) and _Theme_ (allows to change the theme of the application);
+/// * _Settings_: contains the items _Language_ (allows to change the language of the application), _Theme_ (allows to change the theme of the application)
+///   and _Performance overlay_ (\ref Cluedo::UI::PerformanceOverlay);
 /// * _About_: when clicking this item it will show brief information about the application.
 ///
 /// The main window also contains two sections:
-/// * the _Information history_ section that shows the information that was added to the solver;
-/// * the _Solutions_ section that shows the solutions for the game with their respective probabilities.
+/// * the _Information history_ section that shows the information that was added to the solver,
+///   selecting an entry shows the solutions as they were right after that information was learnt
+///   and right clicking it allows to edit or delete it;
+/// * the _Solutions_ section that shows the solutions for the game with their respective probabilities
+///   and, in another tab, a grid with the probability of each player holding each card.
 /// \note This two sections will be available only after a game is created.
 class MainWindow {
 public:
 	/// Constructs the window.
-	explicit MainWindow();
+	///
+	/// \param on_solutions_found The function to be called, from a background
+	/// thread, when the solutions being computed are found.
+	explicit MainWindow(std::function<void()> on_solutions_found = {});
 
 	/// Shows the window.
 	void show();
 
+	/// Returns whether the window is waiting for solutions to be computed.
+	///
+	/// \return `true` if the window is waiting for solutions, `false` otherwise.
+	bool is_computing_solutions() const { return m_pending_solutions.has_value(); }
+
 private:
 	void show_game_menu();
 	void show_settings_menu();
@@ -39,8 +55,23 @@ private:
 	void show_menubar();
 
 	void show_information_history_section();
+	void show_solutions(std::span<Solver::SolutionProbabilityPair const>);
+	void show_card_ownership(Solver::CardOwnershipProbabilities const&);
+	void show_estimate(std::span<Solver::SolutionProbabilityPair const>, Solver::CardOwnershipProbabilities const&);
 	void show_solutions_section();
 
+	std::size_t shown_information_count() const;
+
+	bool learn_information(Solver::Information const&);
+	bool edit_information(std::size_t index, Solver::Information const&);
+	bool remove_information(std::size_t index);
+	void undo_last_information();
+	void select_information(std::optional<std::size_t> index);
+	void forget_solutions_after(std::size_t index);
+	void take_solver_result();
+	void update_information_labels();
+	void update_solution_labels(std::span<Solver::SolutionProbabilityPair const>);
+
 	enum class Style {
 		Light,
 		Dark
@@ -48,9 +79,51 @@ private:
 
 	Style m_style { Style::Dark };
 
-	std::optional<Solver> m_solver;
-	std::vector<std::pair<std::string, Solver>> m_information_history;
-	std::vector<Solver::SolutionProbabilityPair> m_solutions;
+	struct Estimate {
+		std::vector<Solver::SolutionProbabilityPair> solutions;
+		Solver::CardOwnershipProbabilities card_ownership;
+	};
+
+	std::optional<GameLog> m_game_log;
+	// The estimates after each number of information learnt, from none to all
+	// of them. They are empty when they still have to be computed.
+	std::vector<std::optional<Estimate>> m_estimates_after;
+	std::optional<std::size_t> m_selected_information_index;
+	std::optional<std::size_t> m_edited_information_index;
+
+	struct PendingSolutions {
+		std::size_t version;
+		std::size_t information_count;
+	};
+
+	AsyncSolver m_async_solver;
+	std::optional<PendingSolutions> m_pending_solutions;
+	// The estimate of the pending solutions found so far, which is read again
+	// only when the number of samples it is based on doubles.
+	std::optional<SolveResult> m_partial_result;
+
+	// The labels are formatted only when what is shown or the language change,
+	// the generation is increased whenever the shown information or solutions change.
+	struct LabelsKey {
+		std::size_t generation;
+		std::string_view language_id;
+
+		bool operator==(LabelsKey const&) const = default;
+	};
+
+	struct SolutionLabel {
+		std::string text;
+		std::string probability_text;
+		float text_width;
+		float probability;
+	};
+
+	std::size_t m_labels_generation { 0 };
+	std::optional<LabelsKey> m_information_labels_key;
+	std::string m_undo_button_label;
+	std::vector<std::string> m_information_labels;
+	std::optional<LabelsKey> m_solution_labels_key;
+	std::vector<SolutionLabel> m_solution_labels;
 
 	bool m_show_new_game_modal { false };
 	NewGameModal m_new_game_modal;
@@ -60,6 +133,9 @@ private:
 
 	bool m_show_player_data_modal { false };
 	PlayerDataModal m_player_data_modal;
+
+	bool m_show_performance_overlay { false };
+	PerformanceOverlay m_performance_overlay;
 };
 
 }
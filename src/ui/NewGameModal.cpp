@@ -86,9 +86,16 @@ void NewGameModal::show_players_section() {
 
 void NewGameModal::show_buttons() {
 	if (ImGui::Button(CSTR(LS("UI.Ok")))) {
-		auto maybe_solver = Solver::create(m_players);
+		// The solver doesn't know the language, so the players without a name get the placeholder shown in their field.
+		auto players = m_players;
+		for (std::size_t i = 0; i < players.size(); ++i) {
+			if (players[i].name.empty())
+				players[i].name = fmt::format("{} {}", LS("UI.Player"), i + 1);
+		}
+
+		auto maybe_solver = Solver::create(players);
 		if (maybe_solver.is_error()) {
-			m_error_modal.set_error_message(fmt::format("{}: {}!", LS("UI.ErrorWhileCreatingGame"), maybe_solver.release_error()));
+			m_error_modal.set_error_message(fmt::format("{}: {}!", LS("UI.ErrorWhileCreatingGame"), LS(maybe_solver.release_error())));
 			ImGui::OpenPopup(CSTR(LS("UI.Error")));
 		} else {
 			m_error_modal.set_error_message("");
@@ -0,0 +1,77 @@
+#include "PerformanceOverlay.hpp"
+
+#include "../LanguageStrings.hpp"
+#include "../utils/AllocationCounter.hpp"
+
+#include <cfloat>
+#include <fmt/format.h>
+#include <imgui.h>
+
+namespace Cluedo {
+
+namespace UI {
+
+using Milliseconds = std::chrono::duration<float, std::milli>;
+using Seconds = std::chrono::duration<float>;
+
+void PerformanceOverlay::History::add(float value) {
+	values[offset] = value;
+	offset = (offset + 1) % HISTORY_LENGTH;
+}
+
+void PerformanceOverlay::record_frame(std::chrono::nanoseconds show_duration, SolveStatistics const& solve_statistics) {
+	auto now = std::chrono::steady_clock::now();
+	// Only the allocations of the render thread are counted, since the frames are drawn by it.
+	auto allocation_count = Cluedo::thread_allocation_count();
+
+	if (m_last_frame_time) {
+		auto frame_duration = now - *m_last_frame_time;
+		auto busy_duration = solve_statistics.busy_duration - m_last_busy_duration;
+
+		m_frame_time_ms.add(Milliseconds(frame_duration).count());
+		m_allocations_per_frame.add(static_cast<float>(allocation_count - m_last_allocation_count));
+		m_solver_utilization.add(frame_duration.count() > 0 ? 100.0f * static_cast<float>(busy_duration.count()) / static_cast<float>(frame_duration.count()) : 0.0f);
+	}
+
+	m_show_time_ms.add(Milliseconds(show_duration).count());
+
+	auto solve_seconds = Seconds(solve_statistics.last_solve_duration).count();
+	m_solve_time_ms.add(Milliseconds(solve_statistics.last_solve_duration).count());
+	m_samples_per_second.add(solve_seconds > 0.0f ? static_cast<float>(solve_statistics.last_sample_count) / solve_seconds : 0.0f);
+	m_acceptance_rate.add(solve_statistics.last_sample_count > 0 ? 100.0f * static_cast<float>(solve_statistics.last_valid_sample_count) / static_cast<float>(solve_statistics.last_sample_count) : 0.0f);
+
+	m_last_frame_time = now;
+	m_last_busy_duration = solve_statistics.busy_duration;
+	m_last_allocation_count = allocation_count;
+}
+
+void PerformanceOverlay::show_history(std::string_view label, History const& history, std::string_view unit, int precision) {
+	// The text is formatted into a buffer, so that the overlay doesn't count its own allocations.
+	char overlay_text[64];
+	auto result = fmt::format_to_n(overlay_text, sizeof(overlay_text) - 1, "{:.{}f}{}", history.last(), precision, unit);
+	*result.out = '\0';
+
+	ImGui::PushID(&history);
+	ImGui::TextUnformatted(CSTR(label));
+	ImGui::PlotLines("##history", history.values.data(), static_cast<int>(HISTORY_LENGTH), static_cast<int>(history.offset), overlay_text, 0.0f, FLT_MAX, { 320.0f, 48.0f });
+	ImGui::PopID();
+}
+
+void PerformanceOverlay::show(bool* is_open) {
+	ImGui::SetNextWindowPos({ ImGui::GetIO().DisplaySize.x - 16.0f, 48.0f }, ImGuiCond_FirstUseEver, { 1.0f, 0.0f });
+	ImGui::SetNextWindowBgAlpha(0.85f);
+	if (ImGui::Begin(CSTR(LS("UI.PerformanceOverlay")), is_open, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing)) {
+		show_history(LS("UI.FrameTime"), m_frame_time_ms, " ms", 2);
+		show_history(LS("UI.MainWindowTime"), m_show_time_ms, " ms", 2);
+		show_history(LS("UI.SolveTime"), m_solve_time_ms, " ms", 1);
+		show_history(LS("UI.SamplesPerSecond"), m_samples_per_second, "", 0);
+		show_history(LS("UI.AcceptanceRate"), m_acceptance_rate, "%", 2);
+		show_history(LS("UI.AllocationsPerFrame"), m_allocations_per_frame, "", 0);
+		show_history(LS("UI.SolverUtilization"), m_solver_utilization, "%", 1);
+	}
+	ImGui::End();
+}
+
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../AsyncSolver.hpp"
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+/// \file PerformanceOverlay.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::UI::PerformanceOverlay class.
+
+namespace Cluedo {
+
+namespace UI {
+
+/// \brief A window that shows how the application is performing.
+///
+/// The overlay keeps the measurements of the last frames and shows them as
+/// rolling graphs: the frame time, the time spent in \ref Cluedo::UI::MainWindow::show,
+/// the time, the samples per second and the acceptance rate of the last solve,
+/// the heap allocations made by the render thread per frame and how busy the
+/// solver thread is.
+/// \note The frame time includes the time spent waiting for events while the
+/// application is idle.
+class PerformanceOverlay {
+public:
+	/// Constructs the overlay.
+	explicit PerformanceOverlay() = default;
+
+	/// Records the measurements of a frame.
+	/// \note This method must be called once per frame, even when the overlay is
+	/// hidden, from the thread that draws the frames.
+	///
+	/// \param show_duration The time spent showing the main window.
+	/// \param solve_statistics The statistics of the solver.
+	void record_frame(std::chrono::nanoseconds show_duration, SolveStatistics const& solve_statistics);
+
+	/// Shows the overlay.
+	///
+	/// \param is_open Set to `false` when the overlay is closed.
+	void show(bool* is_open);
+
+private:
+	static constexpr std::size_t HISTORY_LENGTH = 120;
+
+	struct History {
+		std::array<float, HISTORY_LENGTH> values {};
+		std::size_t offset { 0 };
+
+		void add(float value);
+		float last() const { return values[(offset + HISTORY_LENGTH - 1) % HISTORY_LENGTH]; }
+	};
+
+	static void show_history(std::string_view label, History const& history, std::string_view unit, int precision);
+
+	History m_frame_time_ms;
+	History m_show_time_ms;
+	History m_solve_time_ms;
+	History m_samples_per_second;
+	History m_acceptance_rate;
+	History m_allocations_per_frame;
+	History m_solver_utilization;
+
+	std::optional<std::chrono::steady_clock::time_point> m_last_frame_time;
+	std::size_t m_last_allocation_count { 0 };
+	std::chrono::nanoseconds m_last_busy_duration { 0 };
+};
+
+}
+
+}
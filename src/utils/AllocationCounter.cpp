@@ -0,0 +1,77 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Counting is a single increment of a variable of the thread, so it is always enabled.
+static thread_local std::size_t t_allocation_count = 0;
+
+namespace Cluedo {
+
+std::size_t thread_allocation_count() {
+	return t_allocation_count;
+}
+
+}
+
+// Like the default operators, the allocation is retried after calling the new handler until there isn't one.
+template<typename Allocate>
+static void* allocate(Allocate&& try_allocate) {
+	++t_allocation_count;
+	while (true) {
+		if (void* pointer = try_allocate())
+			return pointer;
+
+		auto new_handler = std::get_new_handler();
+		if (!new_handler)
+			throw std::bad_alloc();
+
+		new_handler();
+	}
+}
+
+static void* allocate_aligned(std::size_t size, std::align_val_t alignment) {
+	auto alignment_size = static_cast<std::size_t>(alignment);
+	// The size given to aligned_alloc must be a multiple of the alignment.
+	auto aligned_size = (size + alignment_size - 1) / alignment_size * alignment_size;
+	return allocate([aligned_size, alignment_size]() {
+#ifdef _WIN32
+		return _aligned_malloc(aligned_size == 0 ? alignment_size : aligned_size, alignment_size);
+#else
+		return std::aligned_alloc(alignment_size, aligned_size == 0 ? alignment_size : aligned_size);
+#endif
+	});
+}
+
+static void free_aligned(void* pointer) {
+#ifdef _WIN32
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+
+// The array and nothrow forms of the operators call these ones, so they are counted too.
+void* operator new(std::size_t size) {
+	return allocate([size]() { return std::malloc(size == 0 ? 1 : size); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+	free_aligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+	free_aligned(pointer);
+}
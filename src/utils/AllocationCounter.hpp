@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+/// \file AllocationCounter.hpp
+/// \brief The file that contains the declaration of \ref Cluedo::thread_allocation_count.
+
+namespace Cluedo {
+
+/// Returns the number of heap allocations made by the calling thread so far.
+///
+/// The count is kept by the replacements of the global `operator new` in
+/// `AllocationCounter.cpp`, which are linked only into the application.
+/// \note Each thread has its own count, so the render thread doesn't count the
+/// allocations of the solver thread, which copies the solver for every sample.
+///
+/// \return The number of heap allocations made by the calling thread so far.
+std::size_t thread_allocation_count();
+
+}
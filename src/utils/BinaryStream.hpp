@@ -0,0 +1,92 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// \file BinaryStream.hpp
+/// \brief The file that contains the definitions of the \ref Cluedo::BinaryWriter and \ref Cluedo::BinaryReader classes.
+
+namespace Cluedo {
+
+/// \brief A class that appends little-endian integers and strings to a buffer.
+class BinaryWriter {
+public:
+	/// Constructs a writer that appends to the given buffer.
+	///
+	/// \param output The buffer, which must outlive the writer.
+	explicit BinaryWriter(std::string& output)
+	  : m_output(output) {}
+
+	/// Writes an unsigned integer in little-endian order.
+	///
+	/// \param value The integer to write.
+	template<std::unsigned_integral T>
+	void write(T value) {
+		for (std::size_t i = 0; i < sizeof(T); ++i)
+			m_output.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+	}
+
+	/// Writes some bytes as they are.
+	///
+	/// \param bytes The bytes to write.
+	void write_bytes(std::string_view bytes) { m_output.append(bytes); }
+
+private:
+	std::string& m_output;
+};
+
+/// \brief A class that reads little-endian integers and strings from a buffer, without copying it.
+///
+/// Every read fails, returning an empty optional, if there aren't enough bytes left.
+class BinaryReader {
+public:
+	/// Constructs a reader of the given buffer.
+	///
+	/// \param data The buffer, which must outlive the reader.
+	explicit BinaryReader(std::string_view data)
+	  : m_data(data) {}
+
+	/// Reads an unsigned integer in little-endian order.
+	///
+	/// \return The integer read.
+	template<std::unsigned_integral T>
+	std::optional<T> read() {
+		if (remaining_size() < sizeof(T))
+			return std::nullopt;
+
+		T value = 0;
+		for (std::size_t i = 0; i < sizeof(T); ++i)
+			value |= static_cast<T>(static_cast<std::uint8_t>(m_data[m_offset + i])) << (i * 8);
+
+		m_offset += sizeof(T);
+		return value;
+	}
+
+	/// Reads some bytes.
+	///
+	/// \param size The number of bytes to read.
+	///
+	/// \return A view of the bytes read, which points into the buffer.
+	std::optional<std::string_view> read_bytes(std::size_t size) {
+		if (remaining_size() < size)
+			return std::nullopt;
+
+		auto bytes = m_data.substr(m_offset, size);
+		m_offset += size;
+		return bytes;
+	}
+
+	/// Returns the number of bytes read so far.
+	std::size_t offset() const { return m_offset; }
+	/// Returns the number of bytes left to read.
+	std::size_t remaining_size() const { return m_data.size() - m_offset; }
+
+private:
+	std::string_view m_data;
+	std::size_t m_offset { 0 };
+};
+
+}
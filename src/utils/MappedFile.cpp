@@ -0,0 +1,109 @@
+#include "MappedFile.hpp"
+
+#include <utility>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Cluedo {
+
+std::optional<MappedFile> MappedFile::open(std::string const& path) {
+	MappedFile file;
+
+#if defined(_WIN32)
+	auto handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return std::nullopt;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle, &size)) {
+		CloseHandle(handle);
+		return std::nullopt;
+	}
+
+	// An empty file can't be mapped, but there's nothing to map anyway.
+	if (size.QuadPart > 0) {
+		auto mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		file.m_data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		// The view keeps the mapping alive.
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+
+		if (file.m_data == nullptr) {
+			CloseHandle(handle);
+			return std::nullopt;
+		}
+
+		file.m_size = static_cast<std::size_t>(size.QuadPart);
+	}
+
+	CloseHandle(handle);
+#else
+	auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return std::nullopt;
+
+	struct stat status;
+	if (fstat(fd, &status) < 0) {
+		close(fd);
+		return std::nullopt;
+	}
+
+	// An empty file can't be mapped, but there's nothing to map anyway.
+	if (status.st_size > 0) {
+		auto* data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+			return std::nullopt;
+		}
+
+		file.m_data = data;
+		file.m_size = static_cast<std::size_t>(status.st_size);
+	}
+
+	// The mapping keeps the file alive.
+	close(fd);
+#endif
+
+	return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+  : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+	if (this != &other) {
+		unmap();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+	}
+
+	return *this;
+}
+
+MappedFile::~MappedFile() {
+	unmap();
+}
+
+void MappedFile::unmap() {
+	if (m_data == nullptr)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(m_data);
+#else
+	munmap(const_cast<void*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// \file MappedFile.hpp
+/// \brief The file that contains the definition of the \ref Cluedo::MappedFile class.
+
+namespace Cluedo {
+
+/// \brief A file mapped read-only into memory.
+///
+/// The content of the file is read by the operating system only when it's
+/// accessed, and it's shared by all the threads without any copy.
+class MappedFile {
+public:
+	/// Maps a file into memory.
+	///
+	/// \param path The path of the file.
+	///
+	/// \return The mapped file or `std::nullopt` if it couldn't be mapped.
+	static std::optional<MappedFile> open(std::string const& path);
+
+	MappedFile(MappedFile&&);
+	MappedFile& operator=(MappedFile&&);
+	~MappedFile();
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	/// Returns the content of the file.
+	///
+	/// \return The content of the file, which is valid as long as the object is.
+	std::string_view data() const { return { static_cast<char const*>(m_data), m_size }; }
+
+private:
+	MappedFile() = default;
+
+	void unmap();
+
+	void const* m_data { nullptr };
+	std::size_t m_size { 0 };
+};
+
+}